@@ -0,0 +1,159 @@
+/**
+ * @brief Allocation counts for the hot paths, with zero-allocation assertions
+ *
+ * Only meaningful in a build configured with -DECIM_COUNT_ALLOCATIONS=ON.
+ * Exits non-zero when a path with a zero budget allocates, so it can gate
+ * changes to ComponentTableModel::data and LanguageManager::translate.
+ */
+#include "config/LanguageManager.h"
+#include "database/DatabaseManager.h"
+#include "models/PassiveComponent.h"
+#include "ui/ComponentTableModel.h"
+#include "utils/AllocCounter.h"
+#include "utils/SiValue.h"
+
+#include <QGuiApplication>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    int s_failures = 0;
+
+    /// Prints allocations per operation and fails when the budget is exceeded
+    void report(const char *name, const AllocCounter::Counts &counts, quint64 operations, double budget)
+    {
+        double perOp = static_cast<double>(counts.allocations) / static_cast<double>(qMax<quint64>(operations, 1));
+        bool ok = budget < 0.0 || perOp <= budget;
+        std::printf("%-36s %8.2f allocs/op %10.1f bytes/op  %s\n", name, perOp,
+                    static_cast<double>(counts.bytes) / static_cast<double>(qMax<quint64>(operations, 1)),
+                    budget < 0.0 ? "" : (ok ? "ok" : "OVER BUDGET"));
+        if (!ok)
+        {
+            ++s_failures;
+        }
+    }
+
+    std::vector<std::unique_ptr<Component>> makeComponents(int count)
+    {
+        std::vector<std::unique_ptr<Component>> components;
+        components.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            components.push_back(std::make_unique<PassiveComponent>(
+                i + 1, QString("R%1").arg(i), "Yageo", i % 50, "Resistor",
+                1000.0 * (i % 100 + 1), QString::fromUtf8("Ω"), "0805"));
+        }
+        return components;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    if (!AllocCounter::isAvailable())
+    {
+        std::printf("Allocation counting is disabled; reconfigure with -DECIM_COUNT_ALLOCATIONS=ON\n");
+        return 0;
+    }
+
+    const int rows = 2000;
+    Lang.loadLanguage(ECIM_SOURCE_DIR "/lang/en.json");
+
+    QTemporaryDir dir;
+    QString dbPath = dir.filePath("alloc.db");
+    DatabaseManager &db = DatabaseManager::instance();
+    if (!dir.isValid() || !db.initialize(dbPath))
+    {
+        std::printf("Failed to open benchmark database\n");
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Component>> components = makeComponents(rows);
+    for (const auto &component : components)
+    {
+        db.addComponent(component.get());
+    }
+
+    std::printf("Allocation benchmark, %d rows\n", rows);
+
+    // Warm cache: the model formats every cell once when rows are appended
+    ComponentTableModel model;
+    model.appendComponents(makeComponents(rows));
+    {
+        quint64 calls = 0;
+        AllocScope scope;
+        for (int row = 0; row < model.rowCount(); ++row)
+        {
+            for (int column = 0; column < ComponentTableModel::ColumnCount; ++column)
+            {
+                QModelIndex index = model.index(row, column);
+                for (int role : {int(Qt::DisplayRole), int(Qt::ToolTipRole), int(Qt::BackgroundRole),
+                                 int(Qt::ForegroundRole), int(Qt::FontRole), int(Qt::TextAlignmentRole)})
+                {
+                    QVariant value = model.data(index, role);
+                    ++calls;
+                }
+            }
+        }
+        report("ComponentTableModel::data (warm)", scope.delta(), calls, 0.0);
+    }
+
+    {
+        const int calls = 100000;
+        AllocScope scope;
+        qint64 total = 0;
+        for (int i = 0; i < calls; ++i)
+        {
+            total += Lang.translate(TrKey::MenuFileTitle).size();
+        }
+        report("LanguageManager::translate(TrKey)", scope.delta(), calls, 0.0);
+        Q_UNUSED(total);
+    }
+
+    {
+        const int calls = 100000;
+        AllocScope scope;
+        qint64 total = 0;
+        char buffer[SiValue::BUFFER_SIZE];
+        for (int i = 0; i < calls; ++i)
+        {
+            total += static_cast<qint64>(SiValue::format(1e-9 * (i + 1), buffer, sizeof(buffer)));
+        }
+        report("SiValue::format (buffer)", scope.delta(), calls, 0.0);
+        Q_UNUSED(total);
+    }
+
+    {
+        QSqlDatabase reader = QSqlDatabase::addDatabase("QSQLITE", "alloc_bench");
+        reader.setDatabaseName(dbPath);
+        reader.open();
+        {
+            QSqlQuery query(reader);
+            query.setForwardOnly(true);
+            query.exec("SELECT * FROM inventory ORDER BY name");
+            quint64 hydrated = 0;
+            AllocScope scope;
+            while (query.next())
+            {
+                std::unique_ptr<Component> component = DatabaseManager::hydrateComponent(query, db.categoryRegistry());
+                ++hydrated;
+            }
+            // No budget yet; this is the number to drive down
+            report("DatabaseManager::hydrateComponent", scope.delta(), hydrated, -1.0);
+        }
+        reader.close();
+    }
+    QSqlDatabase::removeDatabase("alloc_bench");
+
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+/**
+ * @brief DatabaseManager operations at inventory scale
+ *
+ * Each backend/size pair starts from an empty database, bulk inserts the
+ * rows, then times the read and maintenance operations on top of them.
+ * Results are printed and written as JSON so builds can be compared.
+ * fetchAllSerial repeats fetchAllComponents with a single pool thread, so
+ * the gain from parallel hydration shows next to it. Builds with
+ * ECIM_NATIVE_SQLITE also time fetchAllNative, the same load read through
+ * the sqlite3 handle instead of QSqlQuery.
+ *
+ * Usage: bench_database [--rows 1000,100000,1000000] [--backends disk,memory]
+ *                       [--repeat 3] [--output bench_database.json]
+ */
+#include "database/DatabaseManager.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char *const BENCH_CATEGORY = "Bench";
+
+    struct Result
+    {
+        QString backend;
+        int rows;
+        QString operation;
+        qint64 iterations; ///< Operations per repeat
+        int repeats;
+        qint64 bestNs;
+        qint64 meanNs;
+    };
+
+    /// Cheap deterministic mix of passive, active and custom-category parts
+    std::vector<std::unique_ptr<Component>> makeComponents(int first, int count)
+    {
+        static const double e12[] = {1.0, 1.2, 1.5, 1.8, 2.2, 2.7, 3.3, 3.9, 4.7, 5.6, 6.8, 8.2};
+        static const char *const manufacturers[] = {"Yageo", "Murata", "Vishay", "TDK", "Texas Instruments", "Microchip"};
+
+        std::vector<std::unique_ptr<Component>> components;
+        components.reserve(count);
+        for (int i = first; i < first + count; ++i)
+        {
+            QString manufacturer = manufacturers[i % 6];
+            int quantity = (i * 7919) % 500;
+            switch (i % 20)
+            {
+            case 0:
+                components.push_back(std::make_unique<PassiveComponent>(
+                    -1, QString("BENCH-%1").arg(i), manufacturer, quantity, BENCH_CATEGORY, e12[i % 12], "Ω", "0603"));
+                break;
+            case 1:
+            case 2:
+            case 3:
+                components.push_back(std::make_unique<ActiveComponent>(
+                    -1, QString("IC-%1").arg(i), manufacturer, quantity, "IC", 3.3, 8 + i % 64, ""));
+                break;
+            case 4:
+            case 5:
+            case 6:
+            case 7:
+                components.push_back(std::make_unique<PassiveComponent>(
+                    -1, QString("CAP-%1").arg(i), manufacturer, quantity, "Capacitor", e12[i % 12] * 1e-9, "F", "0805"));
+                break;
+            default:
+                components.push_back(std::make_unique<PassiveComponent>(
+                    -1, QString("RES-%1").arg(i), manufacturer, quantity, "Resistor", e12[i % 12] * 1e3, "Ω", "0805"));
+                break;
+            }
+        }
+        return components;
+    }
+
+    std::vector<Result> s_results;
+
+    class Runner
+    {
+    public:
+        Runner(const QString &backend, int rows) : m_backend(backend), m_rows(rows) {}
+
+        /// Time fn() over repeats; fn performs iterations operations and returns a checksum
+        template <typename Fn>
+        void run(const char *operation, qint64 iterations, int repeats, Fn &&fn)
+        {
+            qint64 best = 0;
+            qint64 total = 0;
+            qint64 sink = 0;
+            for (int i = 0; i < repeats; ++i)
+            {
+                QElapsedTimer timer;
+                timer.start();
+                sink += fn();
+                qint64 elapsed = timer.nsecsElapsed();
+                best = i == 0 ? elapsed : std::min(best, elapsed);
+                total += elapsed;
+            }
+
+            Result result{m_backend, m_rows, operation, iterations, repeats, best, total / repeats};
+            std::printf("%-7s %8d  %-22s %12.3f ms  %12.1f ns/op  (checksum %lld)\n",
+                        qPrintable(m_backend), m_rows, operation, best / 1e6,
+                        static_cast<double>(best) / static_cast<double>(std::max<qint64>(iterations, 1)),
+                        static_cast<long long>(sink));
+            s_results.push_back(result);
+        }
+
+    private:
+        QString m_backend;
+        int m_rows;
+    };
+
+    bool runSuite(const QString &backend, const QString &dbPath, int rows, int repeats)
+    {
+        DatabaseManager &db = DatabaseManager::instance();
+        if (!db.initialize(dbPath))
+        {
+            std::printf("Failed to open %s: %s\n", qPrintable(dbPath), qPrintable(db.lastError().text()));
+            return false;
+        }
+
+        int benchCategory = db.addCategory(CategoryInfo(-1, BENCH_CATEGORY, true, false, "Ω"));
+        Runner runner(backend, rows);
+
+        // Build the rows outside the timer so only the database work is measured
+        std::vector<std::unique_ptr<Component>> components = makeComponents(0, rows);
+        runner.run("bulkInsert", rows, 1, [&]()
+                   { return static_cast<qint64>(db.addComponents(components)); });
+        components.clear();
+
+        // Autocommitted single inserts; on disk every one is a journal sync
+        const int singleInserts = std::min(rows, backend == "disk" ? 200 : 1000);
+        std::vector<std::unique_ptr<Component>> extra = makeComponents(rows, singleInserts);
+        runner.run("addComponent", singleInserts, 1, [&]()
+                   {
+            qint64 total = 0;
+            for (const auto &component : extra)
+                total += db.addComponent(component.get()) > 0 ? 1 : 0;
+            return total; });
+
+        // Everything below reads the whole table, so large sizes get fewer repeats
+        const int readRepeats = rows >= 1000000 ? 1 : repeats;
+        db.setNativeReadsEnabled(false);
+        runner.run("fetchAllComponents", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.fetchAllComponents().size()); });
+
+        // A single pool thread makes ParallelHydrator build every block on the reading thread
+        QThreadPool *pool = QThreadPool::globalInstance();
+        const int poolThreads = pool->maxThreadCount();
+        pool->setMaxThreadCount(1);
+        runner.run("fetchAllSerial", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.fetchAllComponents().size()); });
+        pool->setMaxThreadCount(poolThreads);
+
+        db.setNativeReadsEnabled(true);
+        if (db.nativeReadsAvailable())
+        {
+            runner.run("fetchAllNative", rows, readRepeats, [&]()
+                       { return static_cast<qint64>(db.fetchAllComponents().size()); });
+        }
+        runner.run("fetchByCategory", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.fetchByCategory("Resistor").size()); });
+        runner.run("fetchLowStock", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.fetchLowStock().size()); });
+        runner.run("countLowStock", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.countLowStock()); });
+        runner.run("searchByName", rows, readRepeats, [&]()
+                   { return static_cast<qint64>(db.searchByName("RES-1").size()); });
+
+        // Reassigns every row in the category to Other
+        runner.run("deleteCategory", rows / 20, 1, [&]()
+                   { return static_cast<qint64>(db.deleteCategory(benchCategory) ? 1 : 0); });
+
+        db.close();
+        return true;
+    }
+
+    bool writeJson(const QString &path)
+    {
+        QJsonArray results;
+        for (const Result &result : s_results)
+        {
+            QJsonObject entry;
+            entry["backend"] = result.backend;
+            entry["rows"] = result.rows;
+            entry["operation"] = result.operation;
+            entry["iterations"] = result.iterations;
+            entry["repeats"] = result.repeats;
+            entry["bestNs"] = result.bestNs;
+            entry["meanNs"] = result.meanNs;
+            entry["nsPerOp"] = static_cast<double>(result.bestNs) / static_cast<double>(std::max<qint64>(result.iterations, 1));
+            results.append(entry);
+        }
+
+        QJsonObject root;
+        root["benchmark"] = "database";
+        root["qtVersion"] = qVersion();
+        root["cpu"] = QSysInfo::currentCpuArchitecture();
+        root["os"] = QSysInfo::prettyProductName();
+        root["results"] = results;
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            return false;
+        }
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        return file.commit();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption rowsOption("rows", "Comma-separated row counts.", "list", "1000,100000,1000000");
+    QCommandLineOption backendsOption("backends", "Comma-separated backends: disk, memory.", "list", "disk,memory");
+    QCommandLineOption repeatOption("repeat", "Repeats for read operations.", "count", "3");
+    QCommandLineOption outputOption("output", "JSON results file.", "file", "bench_database.json");
+    parser.addOptions({rowsOption, backendsOption, repeatOption, outputOption});
+    parser.process(app);
+
+    const int repeats = std::max(1, parser.value(repeatOption).toInt());
+    QTemporaryDir dir;
+    if (!dir.isValid())
+    {
+        std::printf("Failed to create a temporary directory\n");
+        return 1;
+    }
+
+    for (const QString &backend : parser.value(backendsOption).split(',', Qt::SkipEmptyParts))
+    {
+        for (const QString &rowsText : parser.value(rowsOption).split(',', Qt::SkipEmptyParts))
+        {
+            int rows = std::max(1, rowsText.toInt());
+            QString dbPath;
+            if (backend == "memory")
+            {
+                dbPath = ":memory:";
+            }
+            else if (backend == "disk")
+            {
+                dbPath = dir.filePath(QString("bench_%1.db").arg(rows));
+            }
+            else
+            {
+                std::printf("Unknown backend: %s\n", qPrintable(backend));
+                return 1;
+            }
+
+            if (!runSuite(backend, dbPath, rows, repeats))
+            {
+                return 1;
+            }
+        }
+    }
+
+    QString output = parser.value(outputOption);
+    if (!writeJson(output))
+    {
+        std::printf("Failed to write %s\n", qPrintable(output));
+        return 1;
+    }
+    std::printf("Results written to %s\n", qPrintable(output));
+    return 0;
+}
@@ -0,0 +1,260 @@
+/**
+ * @brief ComponentTableModel + QSortFilterProxyModel + QTableView under load
+ *
+ * Runs the same model/proxy/view/delegate stack as MainWindow offscreen
+ * and times a full model reset, sorting by every column, typing filter
+ * strings one keystroke at a time and scrolling page by page. Every step
+ * ends with a forced synchronous repaint, so timings are whole frames.
+ * data() calls are counted per step to show how much of the work goes
+ * through the model rather than the delegate's row cache.
+ *
+ * Usage: bench_model_view [--rows 100000] [--frames 300] [--seed 1] [--output bench_model_view.json]
+ */
+#include "database/DatabaseManager.h"
+#include "database/InventoryGenerator.h"
+#include "ui/ComponentTableModel.h"
+#include "ui/InventoryItemDelegate.h"
+#include "utils/LatencyHistogram.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QScrollBar>
+#include <QSortFilterProxyModel>
+#include <QTableView>
+#include <cstdio>
+
+namespace
+{
+    /// Counts data() calls; everything else is the production model
+    class CountingModel : public ComponentTableModel
+    {
+    public:
+        using ComponentTableModel::ComponentTableModel;
+
+        QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+        {
+            ++m_dataCalls;
+            return ComponentTableModel::data(index, role);
+        }
+
+        quint64 takeDataCalls()
+        {
+            quint64 calls = m_dataCalls;
+            m_dataCalls = 0;
+            return calls;
+        }
+
+    private:
+        mutable quint64 m_dataCalls = 0;
+    };
+
+    struct Step
+    {
+        QString name;
+        LatencyHistogram frames;
+        quint64 dataCalls = 0;
+    };
+
+    class Harness
+    {
+    public:
+        Harness(CountingModel &model, QTableView &view) : m_model(model), m_view(view) {}
+
+        /// Run fn, repaint the viewport synchronously and record the frame under name
+        template <typename Fn>
+        void frame(const QString &name, Fn &&fn)
+        {
+            Step &step = stepFor(name);
+            QCoreApplication::processEvents();
+            m_model.takeDataCalls();
+
+            QElapsedTimer timer;
+            timer.start();
+            fn();
+            m_view.viewport()->repaint();
+            step.frames.record(timer.nsecsElapsed());
+            step.dataCalls += m_model.takeDataCalls();
+        }
+
+        void print() const
+        {
+            std::printf("%-24s %7s %10s %10s %10s %10s %14s\n", "step", "frames", "mean ms", "p50 ms", "p99 ms", "max ms", "data()/frame");
+            for (const Step &step : m_steps)
+            {
+                std::printf("%-24s %7llu %10.3f %10.3f %10.3f %10.3f %14.1f\n", qPrintable(step.name),
+                            static_cast<unsigned long long>(step.frames.count()), step.frames.mean() / 1e6,
+                            step.frames.percentile(50) / 1e6, step.frames.percentile(99) / 1e6, step.frames.max() / 1e6,
+                            static_cast<double>(step.dataCalls) / qMax<quint64>(step.frames.count(), 1));
+            }
+        }
+
+        QJsonArray toJson() const
+        {
+            QJsonArray steps;
+            for (const Step &step : m_steps)
+            {
+                QJsonObject entry;
+                entry["step"] = step.name;
+                entry["frames"] = static_cast<qint64>(step.frames.count());
+                entry["meanNs"] = step.frames.mean();
+                entry["p50Ns"] = step.frames.percentile(50);
+                entry["p99Ns"] = step.frames.percentile(99);
+                entry["maxNs"] = step.frames.max();
+                entry["dataCalls"] = static_cast<qint64>(step.dataCalls);
+                steps.append(entry);
+            }
+            return steps;
+        }
+
+    private:
+        Step &stepFor(const QString &name)
+        {
+            for (Step &step : m_steps)
+            {
+                if (step.name == name)
+                    return step;
+            }
+            m_steps.push_back(Step{name, LatencyHistogram(), 0});
+            return m_steps.back();
+        }
+
+        CountingModel &m_model;
+        QTableView &m_view;
+        std::vector<Step> m_steps;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption rowsOption("rows", "Rows to load.", "count", "100000");
+    QCommandLineOption framesOption("frames", "Scroll frames to render.", "count", "300");
+    QCommandLineOption seedOption("seed", "Inventory generator seed.", "n", "1");
+    QCommandLineOption outputOption("output", "JSON results file.", "file", "bench_model_view.json");
+    parser.addOptions({rowsOption, framesOption, seedOption, outputOption});
+    parser.process(app);
+
+    const int rows = qMax(1, parser.value(rowsOption).toInt());
+    const int frames = qMax(1, parser.value(framesOption).toInt());
+
+    // The model reads category thresholds from the database's registry
+    if (!DatabaseManager::instance().initialize(":memory:"))
+    {
+        std::printf("Failed to open an in-memory database\n");
+        return 1;
+    }
+
+    InventoryGenerator::Options options;
+    options.seed = parser.value(seedOption).toULongLong();
+    InventoryGenerator generator(options);
+
+    // Same setup as MainWindow::setupUi
+    CountingModel model;
+    QSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    proxy.setFilterCaseSensitivity(Qt::CaseInsensitive);
+    proxy.setFilterKeyColumn(-1);
+
+    QTableView view;
+    view.setModel(&proxy);
+    view.setSortingEnabled(true);
+    view.setSelectionBehavior(QAbstractItemView::SelectRows);
+    view.setAlternatingRowColors(true);
+    view.horizontalHeader()->setStretchLastSection(true);
+    view.verticalHeader()->setVisible(false);
+    view.setWordWrap(false);
+    InventoryItemDelegate *delegate = new InventoryItemDelegate(&model, &view);
+    view.setItemDelegate(delegate);
+    view.verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view.verticalHeader()->setDefaultSectionSize(delegate->rowHeight());
+    view.resize(1280, 800);
+    view.show();
+    QCoreApplication::processEvents();
+
+    std::printf("Model/view benchmark, %d rows, %d scroll frames\n", rows, frames);
+    Harness harness(model, view);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std::vector<std::unique_ptr<Component>> components = generator.generate(rows);
+        harness.frame("reset", [&]()
+                      { model.setComponents(std::move(components)); });
+    }
+
+    for (int column = 0; column < ComponentTableModel::ColumnCount; ++column)
+    {
+        QString name = QString("sort %1").arg(model.headerData(column, Qt::Horizontal).toString());
+        harness.frame(name, [&]()
+                      { view.sortByColumn(column, Qt::AscendingOrder); });
+        harness.frame(name, [&]()
+                      { view.sortByColumn(column, Qt::DescendingOrder); });
+    }
+
+    // Type each string a character at a time, as onSearchTextChanged sees it, then erase it
+    const QStringList typed = {"RES-4.7k", "murata", "0805", "IC-0"};
+    for (const QString &text : typed)
+    {
+        for (int length = 1; length <= text.size(); ++length)
+        {
+            QString prefix = text.left(length);
+            harness.frame("filter keystroke", [&]()
+                          { proxy.setFilterRegularExpression(ComponentTableModel::searchExpression(prefix)); });
+        }
+        harness.frame("filter clear", [&]()
+                      { proxy.setFilterRegularExpression(QRegularExpression()); });
+    }
+
+    view.sortByColumn(ComponentTableModel::ColName, Qt::AscendingOrder);
+    QScrollBar *scrollBar = view.verticalScrollBar();
+    scrollBar->setValue(0);
+    for (int i = 0; i < frames; ++i)
+    {
+        harness.frame("scroll page", [&]()
+                      {
+            int next = scrollBar->value() + scrollBar->pageStep();
+            scrollBar->setValue(next > scrollBar->maximum() ? 0 : next); });
+    }
+    for (int i = 0; i < frames; ++i)
+    {
+        harness.frame("scroll line", [&]()
+                      { scrollBar->setValue((scrollBar->value() + 1) % (scrollBar->maximum() + 1)); });
+    }
+
+    harness.print();
+
+    QJsonObject root;
+    root["benchmark"] = "modelView";
+    root["qtVersion"] = qVersion();
+    root["rows"] = rows;
+    root["results"] = harness.toJson();
+
+    QString output = parser.value(outputOption);
+    QSaveFile file(output);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        std::printf("Failed to write %s\n", qPrintable(output));
+        return 1;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit())
+    {
+        std::printf("Failed to write %s\n", qPrintable(output));
+        return 1;
+    }
+    std::printf("Results written to %s\n", qPrintable(output));
+    return 0;
+}
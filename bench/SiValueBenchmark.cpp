@@ -0,0 +1,122 @@
+/**
+ * @brief Microbenchmark for SiValue against the previous formatting path
+ *
+ * The legacy formatter below is the if/else chain PassiveComponent used
+ * before SiValue, kept here only as the comparison baseline.
+ */
+#include "utils/SiValue.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    QString legacyFormat(double value)
+    {
+        if (value >= 1e9)
+            return QString::number(value / 1e9, 'g', 3) + "G";
+        else if (value >= 1e6)
+            return QString::number(value / 1e6, 'g', 3) + "M";
+        else if (value >= 1e3)
+            return QString::number(value / 1e3, 'g', 3) + "k";
+        else if (value >= 1)
+            return QString::number(value, 'g', 3);
+        else if (value >= 1e-3)
+            return QString::number(value * 1e3, 'g', 3) + "m";
+        else if (value >= 1e-6)
+            return QString::number(value * 1e6, 'g', 3) + "μ";
+        else if (value >= 1e-9)
+            return QString::number(value * 1e9, 'g', 3) + "n";
+        else if (value >= 1e-12)
+            return QString::number(value * 1e12, 'g', 3) + "p";
+        return QString::number(value, 'g', 3);
+    }
+
+    /// E12 values across every prefix decade, repeated to the requested count
+    std::vector<double> makeValues(int count)
+    {
+        static const double e12[] = {1.0, 1.2, 1.5, 1.8, 2.2, 2.7, 3.3, 3.9, 4.7, 5.6, 6.8, 8.2};
+        std::vector<double> values;
+        values.reserve(count);
+        double decade = 1e-12;
+        for (int i = 0; static_cast<int>(values.size()) < count; ++i)
+        {
+            values.push_back(e12[i % 12] * decade);
+            if (i % 12 == 11)
+            {
+                decade = decade >= 1e9 ? 1e-12 : decade * 10.0;
+            }
+        }
+        return values;
+    }
+
+    template <typename Fn>
+    void run(const char *name, int count, Fn &&fn)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 sink = fn();
+        qint64 elapsed = timer.nsecsElapsed();
+        std::printf("%-28s %10.1f ns/op  (checksum %lld)\n", name,
+                    static_cast<double>(elapsed) / count, static_cast<long long>(sink));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = 1000000;
+    QStringList args = app.arguments();
+    if (args.size() > 1)
+    {
+        count = qMax(1, args.at(1).toInt());
+    }
+
+    const std::vector<double> values = makeValues(count);
+
+    std::vector<QString> inputs;
+    inputs.reserve(values.size());
+    for (double value : values)
+    {
+        inputs.push_back(SiValue::toString(value) + "F");
+    }
+
+    std::printf("SiValue benchmark, %d values\n", count);
+
+    run("legacy QString::number", count, [&]()
+        {
+        qint64 total = 0;
+        for (double value : values)
+            total += legacyFormat(value).size();
+        return total; });
+
+    run("SiValue::toString", count, [&]()
+        {
+        qint64 total = 0;
+        for (double value : values)
+            total += SiValue::toString(value).size();
+        return total; });
+
+    run("SiValue::format (buffer)", count, [&]()
+        {
+        qint64 total = 0;
+        char buffer[SiValue::BUFFER_SIZE];
+        for (double value : values)
+            total += static_cast<qint64>(SiValue::format(value, buffer, sizeof(buffer)));
+        return total; });
+
+    run("SiValue::parse", count, [&]()
+        {
+        qint64 total = 0;
+        double value = 0.0;
+        for (const QString &input : inputs)
+            total += SiValue::parse(input, value) ? 1 : 0;
+        return total; });
+
+    return 0;
+}
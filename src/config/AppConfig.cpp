@@ -14,30 +14,61 @@ AppConfig &AppConfig::instance()
 }
 
 AppConfig::AppConfig()
-    : QObject(nullptr)
+    : QObject(nullptr), m_settings(std::make_shared<const AppSettings>()), m_watchEnabled(true)
 {
-    setDefaults();
+    m_reloadTimer.setSingleShot(true);
+    m_reloadTimer.setInterval(RELOAD_DELAY_MS);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, [this]()
+            { m_reloadTimer.start(); });
+    connect(&m_reloadTimer, &QTimer::timeout, this, &AppConfig::onConfigFileChanged);
 }
 
 AppConfig::~AppConfig() = default;
 
-void AppConfig::setDefaults()
+std::shared_ptr<const AppSettings> AppConfig::settings() const
 {
-    m_settings["app/name"] = DEFAULT_APP_NAME;
-    m_settings["app/version"] = DEFAULT_APP_VERSION;
-    m_settings["app/organization"] = DEFAULT_ORG_NAME;
-
-    m_settings["database/path"] = DEFAULT_DB_PATH;
+    return std::atomic_load(&m_settings);
+}
 
-    m_settings["ui/lowStockThreshold"] = DEFAULT_LOW_STOCK_THRESHOLD;
-    m_settings["ui/showLowStockWarnings"] = true;
-    m_settings["ui/windowWidth"] = DEFAULT_WINDOW_WIDTH;
-    m_settings["ui/windowHeight"] = DEFAULT_WINDOW_HEIGHT;
-    m_settings["ui/sidebarWidth"] = DEFAULT_SIDEBAR_WIDTH;
+void AppConfig::publish(AppSettings settings)
+{
+    ChangedFields changed = diff(*this->settings(), settings);
+    if (changed == NoFieldsChanged)
+    {
+        return;
+    }
 
-    m_settings["features/enableSampleData"] = true;
+    // Only the GUI thread publishes; readers on other threads keep whichever snapshot they loaded
+    std::shared_ptr<const AppSettings> next = std::make_shared<const AppSettings>(std::move(settings));
+    std::atomic_store(&m_settings, std::move(next));
+    emit configChanged(changed);
+}
 
-    m_settings["language/file"] = DEFAULT_LANGUAGE_FILE;
+AppConfig::ChangedFields AppConfig::diff(const AppSettings &before, const AppSettings &after)
+{
+    ChangedFields changed;
+    if (before.appName != after.appName || before.appVersion != after.appVersion ||
+        before.organizationName != after.organizationName)
+        changed |= AppInfoChanged;
+    if (before.databasePath != after.databasePath || before.snapshotEnabled != after.snapshotEnabled ||
+        before.snapshotPath != after.snapshotPath)
+        changed |= DatabasePathChanged;
+    if (before.lowStockThreshold != after.lowStockThreshold)
+        changed |= LowStockThresholdChanged;
+    if (before.showLowStockWarnings != after.showLowStockWarnings)
+        changed |= LowStockWarningsChanged;
+    if (before.windowWidth != after.windowWidth || before.windowHeight != after.windowHeight)
+        changed |= WindowSizeChanged;
+    if (before.sidebarWidth != after.sidebarWidth)
+        changed |= SidebarWidthChanged;
+    if (before.enableSampleData != after.enableSampleData)
+        changed |= SampleDataChanged;
+    if (before.languageFile != after.languageFile)
+        changed |= LanguageFileChanged;
+    if (before.traceEnabled != after.traceEnabled || before.traceFile != after.traceFile ||
+        before.slowQueryMs != after.slowQueryMs || before.stallMs != after.stallMs)
+        changed |= DiagnosticsChanged;
+    return changed;
 }
 
 bool AppConfig::configExists(const QString &filePath) const
@@ -49,6 +80,23 @@ bool AppConfig::load(const QString &filePath)
 {
     QString path = filePath.isEmpty() ? "config.json" : filePath;
 
+    AppSettings settings;
+    if (!readFile(path, settings))
+    {
+        return false;
+    }
+
+    m_configFilePath = path;
+    publish(std::move(settings));
+    watchConfigFile();
+
+    qDebug() << "Configuration loaded from:" << path;
+    emit configLoaded();
+    return true;
+}
+
+bool AppConfig::readFile(const QString &path, AppSettings &settings) const
+{
     QFile file(path);
     if (!file.exists())
     {
@@ -80,14 +128,45 @@ bool AppConfig::load(const QString &filePath)
         return false;
     }
 
-    fromJson(doc.object());
-    m_configFilePath = path;
-
-    qDebug() << "Configuration loaded from:" << path;
-    emit configLoaded();
+    fromJson(doc.object(), settings);
     return true;
 }
 
+void AppConfig::setWatchEnabled(bool enabled)
+{
+    m_watchEnabled = enabled;
+    watchConfigFile();
+}
+
+void AppConfig::watchConfigFile()
+{
+    if (!m_watcher.files().isEmpty())
+    {
+        m_watcher.removePaths(m_watcher.files());
+    }
+
+    if (m_watchEnabled && !m_configFilePath.isEmpty() && QFileInfo::exists(m_configFilePath))
+    {
+        m_watcher.addPath(m_configFilePath);
+    }
+}
+
+void AppConfig::onConfigFileChanged()
+{
+    // Saving by rename drops the path from the watcher, so always re-add it
+    watchConfigFile();
+
+    AppSettings settings;
+    if (!readFile(m_configFilePath, settings))
+    {
+        qWarning() << "Keeping previous configuration";
+        return;
+    }
+
+    qDebug() << "Configuration reloaded from:" << m_configFilePath;
+    publish(std::move(settings));
+}
+
 bool AppConfig::save(const QString &filePath)
 {
     QString path = filePath.isEmpty() ? m_configFilePath : filePath;
@@ -103,66 +182,77 @@ bool AppConfig::save(const QString &filePath)
         return false;
     }
 
-    QJsonDocument doc(toJson());
+    QJsonDocument doc(toJson(*settings()));
     file.write(doc.toJson(QJsonDocument::Indented));
     file.close();
 
     m_configFilePath = path;
+    watchConfigFile();
     qDebug() << "Configuration saved to:" << path;
     emit configSaved();
     return true;
 }
 
-QJsonObject AppConfig::toJson() const
+QJsonObject AppConfig::toJson(const AppSettings &settings)
 {
     QJsonObject root;
 
     // App
     QJsonObject app;
-    app["name"] = m_settings["app/name"].toString();
-    app["version"] = m_settings["app/version"].toString();
-    app["organization"] = m_settings["app/organization"].toString();
+    app["name"] = settings.appName;
+    app["version"] = settings.appVersion;
+    app["organization"] = settings.organizationName;
     root["app"] = app;
 
     // Database
     QJsonObject database;
-    database["path"] = m_settings["database/path"].toString();
+    database["path"] = settings.databasePath;
+    database["snapshot"] = settings.snapshotEnabled;
+    database["snapshotPath"] = settings.snapshotPath;
     root["database"] = database;
 
     // UI
     QJsonObject ui;
-    ui["lowStockThreshold"] = m_settings["ui/lowStockThreshold"].toInt();
-    ui["showLowStockWarnings"] = m_settings["ui/showLowStockWarnings"].toBool();
-    ui["windowWidth"] = m_settings["ui/windowWidth"].toInt();
-    ui["windowHeight"] = m_settings["ui/windowHeight"].toInt();
-    ui["sidebarWidth"] = m_settings["ui/sidebarWidth"].toInt();
+    ui["lowStockThreshold"] = settings.lowStockThreshold;
+    ui["showLowStockWarnings"] = settings.showLowStockWarnings;
+    ui["windowWidth"] = settings.windowWidth;
+    ui["windowHeight"] = settings.windowHeight;
+    ui["sidebarWidth"] = settings.sidebarWidth;
     root["ui"] = ui;
 
     // Features
     QJsonObject features;
-    features["enableSampleData"] = m_settings["features/enableSampleData"].toBool();
+    features["enableSampleData"] = settings.enableSampleData;
     root["features"] = features;
 
     // Language
     QJsonObject language;
-    language["file"] = m_settings["language/file"].toString();
+    language["file"] = settings.languageFile;
     root["language"] = language;
 
+    // Diagnostics
+    QJsonObject diagnostics;
+    diagnostics["trace"] = settings.traceEnabled;
+    diagnostics["traceFile"] = settings.traceFile;
+    diagnostics["slowQueryMs"] = settings.slowQueryMs;
+    diagnostics["stallMs"] = settings.stallMs;
+    root["diagnostics"] = diagnostics;
+
     return root;
 }
 
-void AppConfig::fromJson(const QJsonObject &json)
+void AppConfig::fromJson(const QJsonObject &json, AppSettings &settings)
 {
     // App
     if (json.contains("app") && json["app"].isObject())
     {
         QJsonObject app = json["app"].toObject();
         if (app.contains("name"))
-            m_settings["app/name"] = app["name"].toString();
+            settings.appName = app["name"].toString();
         if (app.contains("version"))
-            m_settings["app/version"] = app["version"].toString();
+            settings.appVersion = app["version"].toString();
         if (app.contains("organization"))
-            m_settings["app/organization"] = app["organization"].toString();
+            settings.organizationName = app["organization"].toString();
     }
 
     // Database
@@ -170,7 +260,11 @@ void AppConfig::fromJson(const QJsonObject &json)
     {
         QJsonObject database = json["database"].toObject();
         if (database.contains("path"))
-            m_settings["database/path"] = database["path"].toString();
+            settings.databasePath = database["path"].toString();
+        if (database.contains("snapshot"))
+            settings.snapshotEnabled = database["snapshot"].toBool();
+        if (database.contains("snapshotPath"))
+            settings.snapshotPath = database["snapshotPath"].toString();
     }
 
     // UI
@@ -178,15 +272,15 @@ void AppConfig::fromJson(const QJsonObject &json)
     {
         QJsonObject ui = json["ui"].toObject();
         if (ui.contains("lowStockThreshold"))
-            m_settings["ui/lowStockThreshold"] = ui["lowStockThreshold"].toInt();
+            settings.lowStockThreshold = ui["lowStockThreshold"].toInt();
         if (ui.contains("showLowStockWarnings"))
-            m_settings["ui/showLowStockWarnings"] = ui["showLowStockWarnings"].toBool();
+            settings.showLowStockWarnings = ui["showLowStockWarnings"].toBool();
         if (ui.contains("windowWidth"))
-            m_settings["ui/windowWidth"] = ui["windowWidth"].toInt();
+            settings.windowWidth = ui["windowWidth"].toInt();
         if (ui.contains("windowHeight"))
-            m_settings["ui/windowHeight"] = ui["windowHeight"].toInt();
+            settings.windowHeight = ui["windowHeight"].toInt();
         if (ui.contains("sidebarWidth"))
-            m_settings["ui/sidebarWidth"] = ui["sidebarWidth"].toInt();
+            settings.sidebarWidth = ui["sidebarWidth"].toInt();
     }
 
     // Features
@@ -194,7 +288,7 @@ void AppConfig::fromJson(const QJsonObject &json)
     {
         QJsonObject features = json["features"].toObject();
         if (features.contains("enableSampleData"))
-            m_settings["features/enableSampleData"] = features["enableSampleData"].toBool();
+            settings.enableSampleData = features["enableSampleData"].toBool();
     }
 
     // Language
@@ -202,111 +296,131 @@ void AppConfig::fromJson(const QJsonObject &json)
     {
         QJsonObject language = json["language"].toObject();
         if (language.contains("file"))
-            m_settings["language/file"] = language["file"].toString();
+            settings.languageFile = language["file"].toString();
     }
 
-    emit configChanged();
+    // Diagnostics
+    if (json.contains("diagnostics") && json["diagnostics"].isObject())
+    {
+        QJsonObject diagnostics = json["diagnostics"].toObject();
+        if (diagnostics.contains("trace"))
+            settings.traceEnabled = diagnostics["trace"].toBool();
+        if (diagnostics.contains("traceFile"))
+            settings.traceFile = diagnostics["traceFile"].toString();
+        if (diagnostics.contains("slowQueryMs"))
+            settings.slowQueryMs = diagnostics["slowQueryMs"].toInt();
+        if (diagnostics.contains("stallMs"))
+            settings.stallMs = diagnostics["stallMs"].toInt();
+    }
 }
 
 QString AppConfig::appName() const
 {
-    return m_settings["app/name"].toString();
+    return settings()->appName;
 }
 
 QString AppConfig::appVersion() const
 {
-    return m_settings["app/version"].toString();
+    return settings()->appVersion;
 }
 
 QString AppConfig::organizationName() const
 {
-    return m_settings["app/organization"].toString();
+    return settings()->organizationName;
 }
 
 QString AppConfig::databasePath() const
 {
-    return m_settings["database/path"].toString();
+    return settings()->databasePath;
 }
 
 void AppConfig::setDatabasePath(const QString &path)
 {
-    m_settings["database/path"] = path;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.databasePath = path;
+    publish(std::move(next));
 }
 
 int AppConfig::lowStockThreshold() const
 {
-    return m_settings["ui/lowStockThreshold"].toInt();
+    return settings()->lowStockThreshold;
 }
 
 void AppConfig::setLowStockThreshold(int threshold)
 {
-    m_settings["ui/lowStockThreshold"] = threshold;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.lowStockThreshold = threshold;
+    publish(std::move(next));
 }
 
 bool AppConfig::showLowStockWarnings() const
 {
-    return m_settings["ui/showLowStockWarnings"].toBool();
+    return settings()->showLowStockWarnings;
 }
 
 void AppConfig::setShowLowStockWarnings(bool show)
 {
-    m_settings["ui/showLowStockWarnings"] = show;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.showLowStockWarnings = show;
+    publish(std::move(next));
 }
 
 int AppConfig::defaultWindowWidth() const
 {
-    return m_settings["ui/windowWidth"].toInt();
+    return settings()->windowWidth;
 }
 
 void AppConfig::setDefaultWindowWidth(int width)
 {
-    m_settings["ui/windowWidth"] = width;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.windowWidth = width;
+    publish(std::move(next));
 }
 
 int AppConfig::defaultWindowHeight() const
 {
-    return m_settings["ui/windowHeight"].toInt();
+    return settings()->windowHeight;
 }
 
 void AppConfig::setDefaultWindowHeight(int height)
 {
-    m_settings["ui/windowHeight"] = height;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.windowHeight = height;
+    publish(std::move(next));
 }
 
 int AppConfig::sidebarWidth() const
 {
-    return m_settings["ui/sidebarWidth"].toInt();
+    return settings()->sidebarWidth;
 }
 
 void AppConfig::setSidebarWidth(int width)
 {
-    m_settings["ui/sidebarWidth"] = width;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.sidebarWidth = width;
+    publish(std::move(next));
 }
 
 bool AppConfig::enableSampleData() const
 {
-    return m_settings["features/enableSampleData"].toBool();
+    return settings()->enableSampleData;
 }
 
 void AppConfig::setEnableSampleData(bool enable)
 {
-    m_settings["features/enableSampleData"] = enable;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.enableSampleData = enable;
+    publish(std::move(next));
 }
 
 QString AppConfig::languageFile() const
 {
-    return m_settings["language/file"].toString();
+    return settings()->languageFile;
 }
 
 void AppConfig::setLanguageFile(const QString &filePath)
 {
-    m_settings["language/file"] = filePath;
-    emit configChanged();
+    AppSettings next = *settings();
+    next.languageFile = filePath;
+    publish(std::move(next));
 }
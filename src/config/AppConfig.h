@@ -3,15 +3,33 @@
 
 #include <QObject>
 #include <QString>
-#include <QVariant>
 #include <QJsonObject>
-#include <QMap>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include "config/AppSettings.h"
+#include <memory>
 
 class AppConfig : public QObject
 {
     Q_OBJECT
 
 public:
+    enum ChangedField
+    {
+        NoFieldsChanged = 0x000,
+        AppInfoChanged = 0x001,
+        DatabasePathChanged = 0x002,
+        LowStockThresholdChanged = 0x004,
+        LowStockWarningsChanged = 0x008,
+        WindowSizeChanged = 0x010,
+        SidebarWidthChanged = 0x020,
+        SampleDataChanged = 0x040,
+        LanguageFileChanged = 0x080,
+        DiagnosticsChanged = 0x100
+    };
+    Q_DECLARE_FLAGS(ChangedFields, ChangedField)
+    Q_FLAG(ChangedFields)
+
     static AppConfig &instance();
 
     AppConfig(const AppConfig &) = delete;
@@ -20,6 +38,15 @@ public:
     bool load(const QString &filePath = "config.json");
     bool save(const QString &filePath = QString());
 
+    /**
+     * Current settings snapshot. Safe to call from any thread; the returned
+     * snapshot never changes, a reload publishes a new one instead.
+     */
+    std::shared_ptr<const AppSettings> settings() const;
+
+    /// Reload config.json automatically when it changes on disk
+    void setWatchEnabled(bool enabled);
+
     // Application settings
     QString appName() const;
     QString appVersion() const;
@@ -58,7 +85,7 @@ public:
     QString configFilePath() const { return m_configFilePath; }
 
 signals:
-    void configChanged();
+    void configChanged(AppConfig::ChangedFields fields);
     void configLoaded();
     void configSaved();
 
@@ -66,25 +93,30 @@ private:
     AppConfig();
     ~AppConfig() override;
 
-    void setDefaults();
-    QJsonObject toJson() const;
-    void fromJson(const QJsonObject &json);
+    bool readFile(const QString &path, AppSettings &settings) const;
+    static QJsonObject toJson(const AppSettings &settings);
+    static void fromJson(const QJsonObject &json, AppSettings &settings);
+    static ChangedFields diff(const AppSettings &before, const AppSettings &after);
+
+    /// Atomically replace the snapshot and report what changed
+    void publish(AppSettings settings);
+
+    void watchConfigFile();
+    void onConfigFileChanged();
 
     QString m_configFilePath;
-    QMap<QString, QVariant> m_settings;
-
-    // Default values
-    static constexpr const char *DEFAULT_APP_NAME = "ElectraBase Pro";
-    static constexpr const char *DEFAULT_APP_VERSION = "1.0.0";
-    static constexpr const char *DEFAULT_ORG_NAME = "ElectraBase";
-    static constexpr const char *DEFAULT_DB_PATH = "inventory.db";
-    static constexpr const char *DEFAULT_LANGUAGE_FILE = "lang/en.json";
-    static constexpr int DEFAULT_LOW_STOCK_THRESHOLD = 10;
-    static constexpr int DEFAULT_WINDOW_WIDTH = 1200;
-    static constexpr int DEFAULT_WINDOW_HEIGHT = 700;
-    static constexpr int DEFAULT_SIDEBAR_WIDTH = 200;
+    std::shared_ptr<const AppSettings> m_settings;
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_reloadTimer;
+    bool m_watchEnabled;
+
+    // Editors often save in several steps, so reloads wait for the file to settle
+    static constexpr int RELOAD_DELAY_MS = 200;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(AppConfig::ChangedFields)
+
 #define Config AppConfig::instance()
 
 #endif // APPCONFIG_H
@@ -0,0 +1,46 @@
+#ifndef APPSETTINGS_H
+#define APPSETTINGS_H
+
+#include <QString>
+
+/**
+ * @brief Immutable snapshot of the application configuration
+ *
+ * AppConfig publishes a new snapshot whenever a setting changes. Readers
+ * hold on to a snapshot and read plain members, so hot paths never look
+ * settings up by key and worker threads never see a half-applied update.
+ */
+struct AppSettings
+{
+    // Application
+    QString appName = "ElectraBase Pro";
+    QString appVersion = "1.0.0";
+    QString organizationName = "ElectraBase";
+
+    // Database
+    QString databasePath = "inventory.db";
+    bool snapshotEnabled = true; // Show the table from a binary snapshot at startup, see InventorySnapshot
+    QString snapshotPath = "inventory.snapshot";
+
+    // UI
+    int lowStockThreshold = 10;
+    bool showLowStockWarnings = true;
+    int windowWidth = 1200;
+    int windowHeight = 700;
+    int sidebarWidth = 200;
+
+    // Feature flags
+    bool enableSampleData = true;
+
+    // Language
+    QString languageFile = "lang/en.json";
+
+    // Diagnostics
+    bool traceEnabled = false;
+    QString traceFile = "trace.json";
+    int slowQueryMs = 50; // Statements slower than this are logged with their query plan
+    int stallMs = 200;    // Event loop stalls longer than this are logged, 0 disables the watchdog.
+                          // Values below StallWatchdog::MIN_THRESHOLD_MS (40) are raised to it
+};
+
+#endif // APPSETTINGS_H
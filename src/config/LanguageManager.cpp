@@ -1,9 +1,12 @@
 #include "config/LanguageManager.h"
 
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
-#include <QJsonArray>
 #include <QDebug>
+#include <algorithm>
+#include <iterator>
 
 LanguageManager &LanguageManager::instance()
 {
@@ -14,11 +17,44 @@ LanguageManager &LanguageManager::instance()
 LanguageManager::LanguageManager()
     : QObject(nullptr), m_currentLanguage("en")
 {
+    m_keyEntries.fill(nullptr);
 }
 
 LanguageManager::~LanguageManager() = default;
 
 bool LanguageManager::loadLanguage(const QString &filePath)
+{
+    const QString packPath = packPathFor(filePath);
+    if (QFileInfo::exists(packPath) && loadPack(packPath, filePath))
+    {
+        return true;
+    }
+    return loadJson(filePath);
+}
+
+bool LanguageManager::loadPack(const QString &packPath, const QString &jsonPath)
+{
+    // A pack older than its source was built from an outdated file
+    QFileInfo packInfo(packPath);
+    QFileInfo jsonInfo(jsonPath);
+    if (jsonInfo.exists() && packInfo.lastModified() < jsonInfo.lastModified())
+    {
+        qWarning() << "Ignoring outdated language pack:" << packPath;
+        return false;
+    }
+
+    QString error;
+    if (!m_table.loadPack(packPath, &error))
+    {
+        qWarning() << "Could not load language pack" << packPath << ":" << error;
+        return false;
+    }
+
+    finishLoad(packPath);
+    return true;
+}
+
+bool LanguageManager::loadJson(const QString &filePath)
 {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly))
@@ -45,86 +81,104 @@ bool LanguageManager::loadLanguage(const QString &filePath)
         return false;
     }
 
-    m_translations = doc.object();
+    m_table.load(doc.object());
+    finishLoad(filePath);
+    return true;
+}
+
+void LanguageManager::finishLoad(const QString &filePath)
+{
+    resolveKeyIds(filePath);
 
     // Get language code from file if present
-    if (m_translations.contains("_meta"))
-    {
-        QJsonObject meta = m_translations["_meta"].toObject();
-        m_currentLanguage = meta.value("language").toString("en");
-    }
+    const TranslationTable::Entry *language = m_table.find(u"_meta.language");
+    m_currentLanguage = (language && !language->text.isEmpty()) ? language->text : QStringLiteral("en");
 
     emit languageChanged();
-    return true;
 }
 
-QString LanguageManager::getNestedValue(const QString &key) const
+QString LanguageManager::packPathFor(const QString &jsonPath)
 {
-    QStringList parts = key.split('.');
-    QJsonObject current = m_translations;
+    QFileInfo info(jsonPath);
+    return info.dir().filePath(info.completeBaseName() + ".langpack");
+}
 
-    for (int i = 0; i < parts.size() - 1; ++i)
+void LanguageManager::resolveKeyIds(const QString &filePath)
+{
+    QStringList missing;
+    for (int i = 0; i < TR_KEY_COUNT; ++i)
     {
-        if (!current.contains(parts[i]))
+        m_keyEntries[i] = m_table.find(TR_KEY_NAMES[i]);
+        if (!m_keyEntries[i])
         {
-            return QString();
+            missing << TR_KEY_NAMES[i];
         }
-        QJsonValue val = current[parts[i]];
-        if (!val.isObject())
-        {
-            return QString();
-        }
-        current = val.toObject();
     }
 
-    if (parts.isEmpty())
+    // Keys in the file that the code has no ID for are most likely typos
+    int resolved = TR_KEY_COUNT - static_cast<int>(missing.size());
+    QStringList unknown;
+    if (resolved != m_table.size())
     {
-        return QString();
+        for (const auto &entry : m_table.entries())
+        {
+            if (!entry.key.startsWith('_') &&
+                std::find(std::begin(TR_KEY_NAMES), std::end(TR_KEY_NAMES), entry.key) == std::end(TR_KEY_NAMES))
+            {
+                unknown << entry.key;
+            }
+        }
     }
 
-    QJsonValue finalValue = current[parts.last()];
-
-    if (finalValue.isString())
+    if (!missing.isEmpty())
     {
-        return finalValue.toString();
+        qWarning() << "Language file" << filePath << "is missing" << missing.size() << "keys:" << missing;
     }
-    else if (finalValue.isArray())
+    if (!unknown.isEmpty())
     {
-        // Return array as comma-separated for simple cases
-        QJsonArray arr = finalValue.toArray();
-        QStringList items;
-        for (const QJsonValue &v : arr)
-        {
-            items << v.toString();
-        }
-        return items.join(",");
+        qWarning() << "Language file" << filePath << "has" << unknown.size() << "unknown keys:" << unknown;
     }
+}
 
-    return QString();
+QString LanguageManager::translate(QAnyStringView key, const QString &defaultValue) const
+{
+    return resolve(m_table.find(key), key, nullptr, 0, defaultValue);
 }
 
-QString LanguageManager::translate(const QString &key, const QString &defaultValue) const
+QString LanguageManager::translate(QAnyStringView key, const QString &arg1, const QString &defaultValue) const
 {
-    QString result = getNestedValue(key);
-    if (result.isEmpty() && !defaultValue.isEmpty())
-    {
-        return defaultValue;
-    }
-    return result.isEmpty() ? key : result;
+    return resolve(m_table.find(key), key, &arg1, 1, defaultValue);
+}
+
+QString LanguageManager::translate(QAnyStringView key, const QStringList &args, const QString &defaultValue) const
+{
+    return resolve(m_table.find(key), key, args.constData(), args.size(), defaultValue);
+}
+
+QString LanguageManager::translate(TrKey key, const QString &defaultValue) const
+{
+    int id = static_cast<int>(key);
+    return resolve(m_keyEntries[id], TR_KEY_NAMES[id], nullptr, 0, defaultValue);
+}
+
+QString LanguageManager::translate(TrKey key, const QString &arg1, const QString &defaultValue) const
+{
+    int id = static_cast<int>(key);
+    return resolve(m_keyEntries[id], TR_KEY_NAMES[id], &arg1, 1, defaultValue);
 }
 
-QString LanguageManager::translate(const QString &key, const QString &arg1, const QString &defaultValue) const
+QString LanguageManager::translate(TrKey key, const QStringList &args, const QString &defaultValue) const
 {
-    QString result = translate(key, defaultValue);
-    return result.arg(arg1);
+    int id = static_cast<int>(key);
+    return resolve(m_keyEntries[id], TR_KEY_NAMES[id], args.constData(), args.size(), defaultValue);
 }
 
-QString LanguageManager::translate(const QString &key, const QStringList &args, const QString &defaultValue) const
+QString LanguageManager::resolve(const TranslationTable::Entry *entry, QAnyStringView key,
+                                 const QString *args, qsizetype argCount, const QString &defaultValue) const
 {
-    QString result = translate(key, defaultValue);
-    for (int i = 0; i < args.size(); ++i)
+    if (entry && !entry->text.isEmpty())
     {
-        result = result.arg(args[i]);
+        return m_table.format(*entry, args, argCount);
     }
-    return result;
+    return TranslationTable::format(defaultValue.isEmpty() ? key.toString() : defaultValue, args, argCount);
 }
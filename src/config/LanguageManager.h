@@ -3,8 +3,11 @@
 
 #include <QObject>
 #include <QString>
-#include <QJsonObject>
-#include <QMap>
+#include <QStringList>
+#include <QAnyStringView>
+#include "config/TranslationTable.h"
+#include "config/TranslationKeys.h"
+#include <array>
 
 class LanguageManager : public QObject
 {
@@ -18,11 +21,24 @@ public:
     LanguageManager(const LanguageManager &) = delete;
     LanguageManager &operator=(const LanguageManager &) = delete;
 
+    /**
+     * Loads a language file. A compiled ".langpack" next to the JSON file is
+     * mapped instead when it is at least as new as the JSON.
+     */
     bool loadLanguage(const QString &filePath);
 
-    QString translate(const QString &key, const QString &defaultValue = QString()) const;
-    QString translate(const QString &key, const QString &arg1, const QString &defaultValue) const;
-    QString translate(const QString &key, const QStringList &args, const QString &defaultValue = QString()) const;
+    /**
+     * Lookups are a single hash probe into the flattened table; strings
+     * without arguments are returned as shared copies without allocating.
+     */
+    QString translate(QAnyStringView key, const QString &defaultValue = QString()) const;
+    QString translate(QAnyStringView key, const QString &arg1, const QString &defaultValue) const;
+    QString translate(QAnyStringView key, const QStringList &args, const QString &defaultValue = QString()) const;
+
+    /// Compile-time checked keys, resolved to table entries when the language is loaded
+    QString translate(TrKey key, const QString &defaultValue = QString()) const;
+    QString translate(TrKey key, const QString &arg1, const QString &defaultValue) const;
+    QString translate(TrKey key, const QStringList &args, const QString &defaultValue = QString()) const;
 
     QString currentLanguage() const { return m_currentLanguage; }
 
@@ -33,9 +49,17 @@ signals:
 private:
     LanguageManager();
 
-    QString getNestedValue(const QString &key) const;
+    bool loadPack(const QString &packPath, const QString &jsonPath);
+    bool loadJson(const QString &filePath);
+    void finishLoad(const QString &filePath);
+    static QString packPathFor(const QString &jsonPath);
+
+    QString resolve(const TranslationTable::Entry *entry, QAnyStringView key,
+                    const QString *args, qsizetype argCount, const QString &defaultValue) const;
+    void resolveKeyIds(const QString &filePath);
 
-    QJsonObject m_translations;
+    TranslationTable m_table;
+    std::array<const TranslationTable::Entry *, TR_KEY_COUNT> m_keyEntries;
     QString m_currentLanguage;
 };
 
@@ -0,0 +1,484 @@
+#include "config/TranslationTable.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+    constexpr quint32 FNV_OFFSET = 2166136261u;
+    constexpr quint32 FNV_PRIME = 16777619u;
+
+    bool isAsciiDigit(QChar c)
+    {
+        return c.unicode() >= u'0' && c.unicode() <= u'9';
+    }
+
+    /*
+     * Language pack layout, native byte order, all offsets 4-byte aligned:
+     *
+     *   PackHeader
+     *   PackEntry[entryCount]
+     *   quint32 buckets[bucketCount]
+     *   Placeholder[placeholderCount]
+     *   char16_t strings[] (keys and texts, not null terminated)
+     */
+    constexpr char PACK_MAGIC[4] = {'E', 'C', 'L', 'P'};
+    constexpr quint32 PACK_VERSION = 1;
+    constexpr quint32 PACK_BYTE_ORDER = 0x01020304;
+
+    struct PackHeader
+    {
+        char magic[4];
+        quint32 version;
+        quint32 byteOrder;
+        quint32 entryCount;
+        quint32 bucketCount;
+        quint32 placeholderCount;
+        quint32 stringsOffset;
+        quint32 stringsLength; // In UTF-16 code units
+    };
+
+    struct PackEntry
+    {
+        quint32 hash;
+        quint32 keyOffset; // In UTF-16 code units from the start of the strings
+        quint32 keyLength;
+        quint32 textOffset;
+        quint32 textLength;
+        quint32 firstPlaceholder;
+        quint32 placeholderCount;
+    };
+
+    static_assert(sizeof(PackHeader) == 32, "PackHeader layout is part of the file format");
+    static_assert(sizeof(PackEntry) == 28, "PackEntry layout is part of the file format");
+    static_assert(sizeof(TranslationTable::Placeholder) == 8, "Placeholder layout is part of the file format");
+
+    /*
+     * Strings from a pack point straight into the mapping, and copies of them
+     * end up in widgets that live as long as the application. A mapping is
+     * therefore never unmapped by clear() or a reload, only retired here.
+     */
+    std::vector<std::shared_ptr<QFile>> &retiredPacks()
+    {
+        static std::vector<std::shared_ptr<QFile>> packs;
+        return packs;
+    }
+
+    void setError(QString *errorString, const QString &message)
+    {
+        if (errorString)
+        {
+            *errorString = message;
+        }
+    }
+}
+
+TranslationTable::TranslationTable()
+    : m_bucketMask(0)
+{
+}
+
+TranslationTable::~TranslationTable() = default;
+
+void TranslationTable::clear()
+{
+    m_entries.clear();
+    m_placeholders.clear();
+    m_buckets.clear();
+    m_bucketMask = 0;
+
+    if (m_pack)
+    {
+        retiredPacks().push_back(std::move(m_pack));
+    }
+}
+
+bool TranslationTable::loadPack(const QString &filePath, QString *errorString)
+{
+    auto file = std::make_shared<QFile>(filePath);
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        setError(errorString, file->errorString());
+        return false;
+    }
+
+    const qint64 fileSize = file->size();
+    if (fileSize < static_cast<qint64>(sizeof(PackHeader)))
+    {
+        setError(errorString, "File too small for a language pack");
+        return false;
+    }
+
+    const uchar *data = file->map(0, fileSize);
+    if (!data)
+    {
+        setError(errorString, file->errorString());
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const PackHeader *>(data);
+    if (std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+        header->version != PACK_VERSION || header->byteOrder != PACK_BYTE_ORDER)
+    {
+        setError(errorString, "Not a language pack for this version and platform");
+        return false;
+    }
+
+    // Bounds check every section before trusting any offset
+    const quint64 entriesOffset = sizeof(PackHeader);
+    const quint64 bucketsOffset = entriesOffset + quint64(header->entryCount) * sizeof(PackEntry);
+    const quint64 placeholdersOffset = bucketsOffset + quint64(header->bucketCount) * sizeof(quint32);
+    const quint64 placeholdersEnd = placeholdersOffset + quint64(header->placeholderCount) * sizeof(Placeholder);
+    const quint64 stringsEnd = quint64(header->stringsOffset) + quint64(header->stringsLength) * sizeof(char16_t);
+
+    const quint32 bucketCount = header->bucketCount;
+    if (placeholdersEnd > header->stringsOffset || stringsEnd > quint64(fileSize) ||
+        header->stringsOffset % alignof(char16_t) != 0 ||
+        bucketCount == 0 || (bucketCount & (bucketCount - 1)) != 0)
+    {
+        setError(errorString, "Corrupt language pack");
+        return false;
+    }
+
+    const auto *entries = reinterpret_cast<const PackEntry *>(data + entriesOffset);
+    const auto *buckets = reinterpret_cast<const quint32 *>(data + bucketsOffset);
+    const auto *placeholders = reinterpret_cast<const Placeholder *>(data + placeholdersOffset);
+    const auto *strings = reinterpret_cast<const QChar *>(data + header->stringsOffset);
+
+    for (quint32 i = 0; i < header->entryCount; ++i)
+    {
+        const PackEntry &entry = entries[i];
+        if (quint64(entry.keyOffset) + entry.keyLength > header->stringsLength ||
+            quint64(entry.textOffset) + entry.textLength > header->stringsLength ||
+            quint64(entry.firstPlaceholder) + entry.placeholderCount > header->placeholderCount)
+        {
+            setError(errorString, "Corrupt language pack entry");
+            return false;
+        }
+    }
+
+    // find() indexes entries by bucket value and probes until it meets an empty bucket
+    bool hasEmptyBucket = false;
+    for (quint32 i = 0; i < bucketCount; ++i)
+    {
+        if (buckets[i] > header->entryCount)
+        {
+            setError(errorString, "Corrupt language pack bucket");
+            return false;
+        }
+        hasEmptyBucket = hasEmptyBucket || buckets[i] == 0;
+    }
+    if (!hasEmptyBucket)
+    {
+        setError(errorString, "Corrupt language pack bucket");
+        return false;
+    }
+
+    clear();
+
+    m_entries.resize(header->entryCount);
+    for (quint32 i = 0; i < header->entryCount; ++i)
+    {
+        const PackEntry &source = entries[i];
+        Entry &entry = m_entries[i];
+        entry.key = QString::fromRawData(strings + source.keyOffset, source.keyLength);
+        entry.text = QString::fromRawData(strings + source.textOffset, source.textLength);
+        entry.hash = source.hash;
+        entry.firstPlaceholder = source.firstPlaceholder;
+        entry.placeholderCount = source.placeholderCount;
+    }
+
+    m_buckets.assign(buckets, buckets + bucketCount);
+    m_bucketMask = bucketCount - 1;
+    m_placeholders.assign(placeholders, placeholders + header->placeholderCount);
+    m_pack = std::move(file);
+
+    return true;
+}
+
+bool TranslationTable::writePack(const QString &filePath, QString *errorString) const
+{
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.byteOrder = PACK_BYTE_ORDER;
+    header.entryCount = static_cast<quint32>(m_entries.size());
+    header.bucketCount = static_cast<quint32>(m_buckets.size());
+    header.placeholderCount = static_cast<quint32>(m_placeholders.size());
+
+    std::vector<PackEntry> entries;
+    entries.reserve(m_entries.size());
+    QString strings;
+    for (const Entry &entry : m_entries)
+    {
+        PackEntry packed;
+        packed.hash = entry.hash;
+        packed.keyOffset = static_cast<quint32>(strings.size());
+        packed.keyLength = static_cast<quint32>(entry.key.size());
+        strings += entry.key;
+        packed.textOffset = static_cast<quint32>(strings.size());
+        packed.textLength = static_cast<quint32>(entry.text.size());
+        strings += entry.text;
+        packed.firstPlaceholder = entry.firstPlaceholder;
+        packed.placeholderCount = entry.placeholderCount;
+        entries.push_back(packed);
+    }
+
+    header.stringsOffset = static_cast<quint32>(sizeof(PackHeader) + entries.size() * sizeof(PackEntry) +
+                                                m_buckets.size() * sizeof(quint32) +
+                                                m_placeholders.size() * sizeof(Placeholder));
+    header.stringsLength = static_cast<quint32>(strings.size());
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        setError(errorString, file.errorString());
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(entries.data()), static_cast<qint64>(entries.size() * sizeof(PackEntry)));
+    file.write(reinterpret_cast<const char *>(m_buckets.data()), static_cast<qint64>(m_buckets.size() * sizeof(quint32)));
+    file.write(reinterpret_cast<const char *>(m_placeholders.data()),
+               static_cast<qint64>(m_placeholders.size() * sizeof(Placeholder)));
+    file.write(reinterpret_cast<const char *>(strings.utf16()), static_cast<qint64>(strings.size() * sizeof(char16_t)));
+
+    if (!file.commit())
+    {
+        setError(errorString, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+void TranslationTable::load(const QJsonObject &root)
+{
+    clear();
+    flatten(root, QString());
+    buildIndex();
+}
+
+void TranslationTable::flatten(const QJsonObject &object, const QString &prefix)
+{
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+    {
+        const QString key = prefix.isEmpty() ? it.key() : prefix + '.' + it.key();
+        const QJsonValue value = it.value();
+
+        if (value.isObject())
+        {
+            flatten(value.toObject(), key);
+        }
+        else if (value.isString())
+        {
+            addEntry(key, value.toString());
+        }
+        else if (value.isArray())
+        {
+            // Arrays are exposed comma-separated for simple cases
+            QStringList items;
+            for (const QJsonValue &item : value.toArray())
+            {
+                items << item.toString();
+            }
+            addEntry(key, items.join(","));
+        }
+    }
+}
+
+void TranslationTable::addEntry(const QString &key, const QString &text)
+{
+    Entry entry;
+    entry.key = key;
+    entry.text = text;
+    entry.hash = hashKey(key);
+    entry.firstPlaceholder = static_cast<quint32>(m_placeholders.size());
+
+    scanPlaceholders(text, m_placeholders);
+    entry.placeholderCount = static_cast<quint32>(m_placeholders.size()) - entry.firstPlaceholder;
+
+    m_entries.push_back(std::move(entry));
+}
+
+void TranslationTable::buildIndex()
+{
+    // Keep the load factor at or below 1/2 so probe chains stay short
+    quint32 capacity = 16;
+    while (capacity < m_entries.size() * 2)
+    {
+        capacity *= 2;
+    }
+
+    m_buckets.assign(capacity, 0);
+    m_bucketMask = capacity - 1;
+
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        quint32 bucket = m_entries[i].hash & m_bucketMask;
+        while (m_buckets[bucket] != 0)
+        {
+            bucket = (bucket + 1) & m_bucketMask;
+        }
+        m_buckets[bucket] = static_cast<quint32>(i + 1);
+    }
+}
+
+const TranslationTable::Entry *TranslationTable::find(QAnyStringView key) const
+{
+    if (m_buckets.empty())
+    {
+        return nullptr;
+    }
+
+    const quint32 hash = hashKey(key);
+    quint32 bucket = hash & m_bucketMask;
+
+    while (m_buckets[bucket] != 0)
+    {
+        const Entry &entry = m_entries[m_buckets[bucket] - 1];
+        if (entry.hash == hash && QAnyStringView::equal(entry.key, key))
+        {
+            return &entry;
+        }
+        bucket = (bucket + 1) & m_bucketMask;
+    }
+
+    return nullptr;
+}
+
+QString TranslationTable::format(const Entry &entry, const QString *args, qsizetype argCount) const
+{
+    if (entry.placeholderCount == 0 || argCount == 0)
+    {
+        return entry.text;
+    }
+    return substitute(entry.text, m_placeholders.data() + entry.firstPlaceholder,
+                      entry.placeholderCount, args, argCount);
+}
+
+QString TranslationTable::format(const QString &text, const QString *args, qsizetype argCount)
+{
+    std::vector<Placeholder> placeholders;
+    scanPlaceholders(text, placeholders);
+    if (placeholders.empty() || argCount == 0)
+    {
+        return text;
+    }
+    return substitute(text, placeholders.data(), static_cast<qsizetype>(placeholders.size()), args, argCount);
+}
+
+quint32 TranslationTable::hashKey(QAnyStringView key)
+{
+    // FNV-1a over code units
+    return key.visit([](auto view)
+                     {
+        using View = std::decay_t<decltype(view)>;
+        quint32 hash = FNV_OFFSET;
+        if constexpr (std::is_same_v<View, QStringView>)
+        {
+            const char16_t *data = view.utf16();
+            for (qsizetype i = 0; i < view.size(); ++i)
+            {
+                hash = (hash ^ data[i]) * FNV_PRIME;
+            }
+        }
+        else
+        {
+            const auto *data = reinterpret_cast<const unsigned char *>(view.data());
+            for (qsizetype i = 0; i < view.size(); ++i)
+            {
+                hash = (hash ^ data[i]) * FNV_PRIME;
+            }
+        }
+        return hash; });
+}
+
+void TranslationTable::scanPlaceholders(QStringView text, std::vector<Placeholder> &out)
+{
+    const size_t first = out.size();
+
+    for (qsizetype i = 0; i + 1 < text.size(); ++i)
+    {
+        if (text[i] != u'%' || !isAsciiDigit(text[i + 1]))
+        {
+            continue;
+        }
+
+        // QString::arg accepts %1 to %99
+        qsizetype end = i + 2;
+        if (end < text.size() && isAsciiDigit(text[end]))
+        {
+            ++end;
+        }
+
+        int number = text.mid(i + 1, end - i - 1).toInt();
+        if (number < 1)
+        {
+            continue;
+        }
+
+        Placeholder placeholder;
+        placeholder.position = static_cast<quint32>(i);
+        placeholder.length = static_cast<quint16>(end - i);
+        placeholder.argIndex = static_cast<quint16>(number); // Replaced by its rank below
+        out.push_back(placeholder);
+        i = end - 1;
+    }
+
+    // Chained QString::arg calls fill the lowest remaining number first,
+    // so the Nth distinct number takes the Nth argument
+    std::vector<quint16> numbers;
+    for (size_t i = first; i < out.size(); ++i)
+    {
+        numbers.push_back(out[i].argIndex);
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+    for (size_t i = first; i < out.size(); ++i)
+    {
+        auto rank = std::lower_bound(numbers.begin(), numbers.end(), out[i].argIndex) - numbers.begin();
+        out[i].argIndex = static_cast<quint16>(rank);
+    }
+}
+
+QString TranslationTable::substitute(const QString &text, const Placeholder *placeholders, qsizetype count,
+                                     const QString *args, qsizetype argCount)
+{
+    qsizetype size = text.size();
+    for (qsizetype i = 0; i < count; ++i)
+    {
+        if (placeholders[i].argIndex < argCount)
+        {
+            size += args[placeholders[i].argIndex].size() - placeholders[i].length;
+        }
+    }
+
+    QString result;
+    result.reserve(size);
+
+    const QStringView view(text);
+    qsizetype last = 0;
+    for (qsizetype i = 0; i < count; ++i)
+    {
+        const Placeholder &placeholder = placeholders[i];
+        result.append(view.mid(last, placeholder.position - last));
+        if (placeholder.argIndex < argCount)
+        {
+            result.append(args[placeholder.argIndex]);
+        }
+        else
+        {
+            result.append(view.mid(placeholder.position, placeholder.length));
+        }
+        last = placeholder.position + placeholder.length;
+    }
+    result.append(view.mid(last));
+
+    return result;
+}
@@ -0,0 +1,93 @@
+#ifndef TRANSLATIONTABLE_H
+#define TRANSLATIONTABLE_H
+
+#include <QAnyStringView>
+#include <QJsonObject>
+#include <QString>
+#include <QStringView>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+/**
+ * @brief Flat, precompiled form of a language file
+ *
+ * Nested JSON objects are flattened once into dotted keys ("menu.file.title").
+ * The keys sit in an open-addressing hash index and each value keeps the
+ * positions of its %N placeholders. A lookup is then one hash probe with
+ * no allocation, and argument substitution is a single pass.
+ *
+ * The table can also be written to and loaded from a binary language pack
+ * (see writePack()). A loaded pack is memory-mapped and its strings are
+ * referenced in place, so nothing is parsed at startup.
+ */
+class TranslationTable
+{
+public:
+    struct Placeholder
+    {
+        quint32 position; ///< Offset of '%' in the text
+        quint16 length;   ///< Length of the marker, e.g. 2 for "%1"
+        quint16 argIndex; ///< Argument used, following QString::arg's lowest-number-first order
+    };
+
+    struct Entry
+    {
+        QString key;
+        QString text;
+        quint32 hash = 0;
+        quint32 firstPlaceholder = 0;
+        quint32 placeholderCount = 0;
+    };
+
+    TranslationTable();
+    ~TranslationTable();
+
+    TranslationTable(const TranslationTable &) = delete;
+    TranslationTable &operator=(const TranslationTable &) = delete;
+
+    /// Replace the table contents with the flattened JSON object
+    void load(const QJsonObject &root);
+
+    /// Replace the table contents with a memory-mapped language pack
+    bool loadPack(const QString &filePath, QString *errorString = nullptr);
+
+    /// Serialize the table as a language pack
+    bool writePack(const QString &filePath, QString *errorString = nullptr) const;
+
+    void clear();
+
+    /// Keys are ASCII, so hashing works the same for UTF-8, Latin-1 and UTF-16 views
+    const Entry *find(QAnyStringView key) const;
+
+    /// Substitute args into an entry's precomputed placeholders
+    QString format(const Entry &entry, const QString *args, qsizetype argCount) const;
+
+    /// Substitute args into text that isn't part of the table (e.g. fallback strings)
+    static QString format(const QString &text, const QString *args, qsizetype argCount);
+
+    int size() const { return static_cast<int>(m_entries.size()); }
+    const std::vector<Entry> &entries() const { return m_entries; }
+
+    static quint32 hashKey(QAnyStringView key);
+
+private:
+    void flatten(const QJsonObject &object, const QString &prefix);
+    void addEntry(const QString &key, const QString &text);
+    void buildIndex();
+
+    static void scanPlaceholders(QStringView text, std::vector<Placeholder> &out);
+    static QString substitute(const QString &text, const Placeholder *placeholders, qsizetype count,
+                              const QString *args, qsizetype argCount);
+
+    std::vector<Entry> m_entries;
+    std::vector<Placeholder> m_placeholders;
+    std::vector<quint32> m_buckets; // Entry index + 1, 0 for an empty bucket
+    quint32 m_bucketMask;
+
+    // Mapped pack backing the entry strings when loaded with loadPack()
+    std::shared_ptr<QFile> m_pack;
+};
+
+#endif // TRANSLATIONTABLE_H
@@ -0,0 +1,238 @@
+#include "database/ComponentExporter.h"
+#include "models/ComponentJson.h"
+#include "utils/Trace.h"
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QLocale>
+#include <QSaveFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QThread>
+
+namespace
+{
+    QString nextConnectionName()
+    {
+        static QAtomicInt counter;
+        return QString("ElectraBaseExporter%1").arg(counter.fetchAndAddRelaxed(1));
+    }
+
+    /// RFC 4180: quote fields holding a delimiter, quote or line break, doubling inner quotes
+    void appendCsvField(QByteArray &out, const QString &value)
+    {
+        QByteArray utf8 = value.toUtf8();
+        bool needsQuotes = false;
+        for (char c : utf8)
+        {
+            if (c == ',' || c == '"' || c == '\n' || c == '\r')
+            {
+                needsQuotes = true;
+                break;
+            }
+        }
+
+        if (!needsQuotes)
+        {
+            out += utf8;
+            return;
+        }
+        out += '"';
+        out += utf8.replace("\"", "\"\"");
+        out += '"';
+    }
+
+    /// Shortest text that reads back as the same double, so values survive a round trip
+    void appendNumber(QByteArray &out, double value)
+    {
+        out += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    }
+}
+
+ComponentExporter::ComponentExporter(const QString &databasePath, const CategoryRegistry &registry, QueryStats &stats,
+                                     const ComponentFilter &filter, int defaultThreshold,
+                                     const QString &outputPath, Format format)
+    : QObject(nullptr), m_databasePath(databasePath), m_registry(registry), m_stats(stats), m_filter(filter),
+      m_defaultThreshold(defaultThreshold), m_outputPath(outputPath), m_format(format), m_written(0)
+{
+}
+
+ComponentExporter::Format ComponentExporter::formatForPath(const QString &path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "jsonl" || suffix == "ndjson" || suffix == "json" ? JsonLines : Csv;
+}
+
+QByteArray ComponentExporter::csvHeader()
+{
+    return "id,name,category,manufacturer,quantity,min_stock,value,unit,package,voltage,pins,datasheet\n";
+}
+
+void ComponentExporter::appendCsvRow(QByteArray &out, const Component &component)
+{
+    out += QByteArray::number(component.getId());
+    out += ',';
+    appendCsvField(out, component.getName());
+    out += ',';
+    appendCsvField(out, component.getCategory());
+    out += ',';
+    appendCsvField(out, component.getManufacturer());
+    out += ',';
+    out += QByteArray::number(component.getQuantity());
+    out += ',';
+    if (component.hasMinStock())
+        out += QByteArray::number(component.getMinStock());
+    out += ',';
+
+    // Passive columns first, then active ones; the other kind's columns stay empty
+    if (auto *passive = dynamic_cast<const PassiveComponent *>(&component))
+    {
+        appendNumber(out, passive->getValue());
+        out += ',';
+        appendCsvField(out, passive->getUnit());
+        out += ',';
+        appendCsvField(out, passive->getPackage());
+        out += ",,,";
+    }
+    else if (auto *active = dynamic_cast<const ActiveComponent *>(&component))
+    {
+        out += ",,,";
+        appendNumber(out, active->getOperatingVoltage());
+        out += ',';
+        out += QByteArray::number(active->getPinCount());
+        out += ',';
+        appendCsvField(out, active->getDatasheetLink());
+    }
+    else
+    {
+        out += ",,,,,";
+    }
+    out += '\n';
+}
+
+void ComponentExporter::appendJsonLine(QByteArray &out, const Component &component)
+{
+    out += QJsonDocument(ComponentJson::toJson(component)).toJson(QJsonDocument::Compact);
+    out += '\n';
+}
+
+void ComponentExporter::run()
+{
+    const QString connectionName = nextConnectionName();
+    bool ok = false;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(m_databasePath);
+        database.setConnectOptions("QSQLITE_OPEN_READONLY");
+
+        if (!database.open())
+        {
+            emit failed(QString("Failed to open database: %1").arg(database.lastError().text()));
+        }
+        else
+        {
+            ok = exportRows(database);
+            database.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    if (ok)
+    {
+        emit finished(m_written);
+    }
+}
+
+bool ComponentExporter::exportRows(QSqlDatabase &database)
+{
+    TRACE_SCOPE("db", "ComponentExporter::exportRows");
+
+    // One read transaction so the count and the rows see the same snapshot
+    database.transaction();
+
+    qint64 total = 0;
+    {
+        TimedQuery countQuery(database, m_stats);
+        countQuery.prepare(DatabaseManager::filteredComponentSql(m_filter, true));
+        DatabaseManager::bindComponentFilter(countQuery, m_filter, m_defaultThreshold);
+        if (countQuery.exec() && countQuery.next())
+        {
+            total = countQuery.value(0).toLongLong();
+        }
+    }
+
+    TimedQuery query(database, m_stats);
+    query.setForwardOnly(true);
+    query.prepare(DatabaseManager::filteredComponentSql(m_filter));
+    DatabaseManager::bindComponentFilter(query, m_filter, m_defaultThreshold);
+    if (!query.exec())
+    {
+        emit failed(QString("Failed to read components: %1").arg(query.lastError().text()));
+        return false;
+    }
+
+    QSaveFile file(m_outputPath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        emit failed(QString("Cannot write %1: %2").arg(m_outputPath, file.errorString()));
+        return false;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(WRITE_BUFFER_SIZE + 4096);
+    if (m_format == Csv)
+    {
+        buffer += csvHeader();
+    }
+
+    auto flush = [&]()
+    {
+        bool written = file.write(buffer) == buffer.size();
+        buffer.truncate(0); // Keeps the capacity, unlike clear()
+        return written;
+    };
+
+    QThread *thread = QThread::currentThread();
+    emit progress(0, total);
+    while (query.next())
+    {
+        if (thread->isInterruptionRequested())
+        {
+            file.cancelWriting();
+            emit cancelled();
+            return false;
+        }
+
+        std::unique_ptr<Component> component = DatabaseManager::hydrateComponent(query, m_registry);
+        if (!component)
+        {
+            continue;
+        }
+
+        if (m_format == Csv)
+            appendCsvRow(buffer, *component);
+        else
+            appendJsonLine(buffer, *component);
+        ++m_written;
+
+        if (buffer.size() >= WRITE_BUFFER_SIZE && !flush())
+        {
+            break;
+        }
+        if (m_written % PROGRESS_INTERVAL == 0)
+        {
+            emit progress(m_written, total);
+        }
+    }
+
+    query.finish();
+    database.commit();
+
+    if (!flush() || !file.commit())
+    {
+        emit failed(QString("Failed to write %1: %2").arg(m_outputPath, file.errorString()));
+        return false;
+    }
+    emit progress(m_written, total);
+    return true;
+}
@@ -0,0 +1,76 @@
+#ifndef COMPONENTEXPORTER_H
+#define COMPONENTEXPORTER_H
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include "database/DatabaseManager.h"
+#include "models/CategoryRegistry.h"
+
+class QSqlDatabase;
+
+/**
+ * @brief Writes the inventory to CSV or JSON Lines from a worker thread
+ *
+ * Like ComponentLoader, the exporter opens its own read-only connection,
+ * so it can run next to the UI. Rows go straight from a forward-only
+ * query into a small write buffer, one component at a time, so memory use
+ * does not depend on the inventory size. The output goes through
+ * QSaveFile and only replaces the target when the export completes.
+ * Interrupting the thread cancels the export and leaves the target
+ * untouched.
+ *
+ * The CSV columns match the ones CsvImporter reads, so an export can be
+ * imported again.
+ *
+ * Both statements are timed into the given QueryStats, which must outlive
+ * the exporter.
+ */
+class ComponentExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format
+    {
+        Csv,
+        JsonLines
+    };
+
+    ComponentExporter(const QString &databasePath, const CategoryRegistry &registry, QueryStats &stats,
+                      const ComponentFilter &filter, int defaultThreshold, const QString &outputPath, Format format);
+
+    /// JsonLines for .jsonl, .ndjson and .json, otherwise Csv
+    static Format formatForPath(const QString &path);
+
+    static QByteArray csvHeader();
+    static void appendCsvRow(QByteArray &out, const Component &component);
+    static void appendJsonLine(QByteArray &out, const Component &component);
+
+    static constexpr int WRITE_BUFFER_SIZE = 256 * 1024;
+    static constexpr int PROGRESS_INTERVAL = 1000;
+
+public slots:
+    void run();
+
+signals:
+    void progress(qint64 written, qint64 total);
+    void finished(qint64 written);
+    void cancelled();
+    void failed(const QString &message);
+
+private:
+    /// Returns false after emitting failed() or cancelled()
+    bool exportRows(QSqlDatabase &database);
+
+    QString m_databasePath;
+    CategoryRegistry m_registry;
+    QueryStats &m_stats;
+    ComponentFilter m_filter;
+    int m_defaultThreshold;
+    QString m_outputPath;
+    Format m_format;
+    qint64 m_written;
+};
+
+#endif // COMPONENTEXPORTER_H
@@ -0,0 +1,123 @@
+#include "database/ComponentLoader.h"
+#include "database/DatabaseManager.h"
+#include "database/NativeRowReader.h"
+#include "database/ParallelHydrator.h"
+#include "database/QueryStats.h"
+#include "utils/Trace.h"
+#include <QAtomicInt>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QThread>
+#include <algorithm>
+
+namespace
+{
+    QString nextConnectionName()
+    {
+        static QAtomicInt counter;
+        return QString("ElectraBaseLoader%1").arg(counter.fetchAndAddRelaxed(1));
+    }
+}
+
+ComponentLoader::ComponentLoader(const QString &databasePath, const CategoryRegistry &registry, QueryStats &stats,
+                                 int firstBatchSize, int batchSize)
+    : QObject(nullptr), m_databasePath(databasePath), m_registry(registry), m_stats(stats),
+      m_firstBatchSize(std::max(1, firstBatchSize)), m_batchSize(std::max(1, batchSize)), m_loaded(0)
+{
+    qRegisterMetaType<ComponentBatch>();
+}
+
+void ComponentLoader::run()
+{
+    const QString connectionName = nextConnectionName();
+    bool ok = false;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(m_databasePath);
+        database.setConnectOptions("QSQLITE_OPEN_READONLY");
+
+        if (!database.open())
+        {
+            emit failed(QString("Failed to open database: %1").arg(database.lastError().text()));
+        }
+        else
+        {
+            ok = load(database);
+            database.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    if (ok)
+    {
+        emit finished(m_loaded);
+    }
+}
+
+bool ComponentLoader::load(QSqlDatabase &database)
+{
+    TRACE_SCOPE("db", "ComponentLoader::load");
+    const QString sql = "SELECT * FROM inventory ORDER BY name";
+
+    // Rows come from the native handle when this build can use it, else through QSqlQuery
+    NativeRowReader reader(database);
+    const bool native = reader.isValid();
+    ComponentRow row;
+
+    TimedQuery query(database, m_stats);
+    query.setForwardOnly(true);
+    bool executed;
+    const qint64 prepareStart = Trace::nowNs();
+    {
+        TRACE_SCOPE("db", "ComponentLoader::query");
+        executed = native ? reader.prepare(sql) : query.exec(sql);
+    }
+    const qint64 prepareNs = Trace::nowNs() - prepareStart;
+    if (!executed)
+    {
+        emit failed(QString("Failed to fetch components: %1")
+                        .arg(native ? reader.lastError() : query.lastError().text()));
+        return false;
+    }
+
+    // Rows are read here and built on the thread pool; every block becomes one batch, in row order
+    ParallelHydrator hydrator(
+        m_registry, [this](ParallelHydrator::Block &&block)
+        {
+            m_loaded += static_cast<int>(block.size());
+            emit batchLoaded(std::make_shared<ParallelHydrator::Block>(std::move(block)));
+        },
+        m_batchSize, m_firstBatchSize);
+
+    QThread *thread = QThread::currentThread();
+    const qint64 stepStart = Trace::nowNs();
+    qint64 rows = 0;
+    while (native ? reader.next(row) : query.next())
+    {
+        if (thread->isInterruptionRequested())
+        {
+            return false;
+        }
+        ++rows;
+
+        if (!native)
+        {
+            DatabaseManager::readComponentRow(query, row);
+        }
+        hydrator.addRow(std::move(row));
+    }
+
+    if (native && reader.hasError())
+    {
+        emit failed(QString("Failed to fetch components: %1").arg(reader.lastError()));
+        return false;
+    }
+    if (native)
+    {
+        // The step time includes waiting for the pool when the hydrator's pipeline is full
+        TimedQuery::record(m_stats, database, sql, prepareNs, 0, Trace::nowNs() - stepStart, rows);
+    }
+
+    hydrator.finish();
+    return true;
+}
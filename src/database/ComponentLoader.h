@@ -0,0 +1,58 @@
+#ifndef COMPONENTLOADER_H
+#define COMPONENTLOADER_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <vector>
+#include "models/Component.h"
+#include "models/CategoryRegistry.h"
+
+class QueryStats;
+
+/// Queued signals need copyable arguments, so batches travel behind a shared_ptr
+using ComponentBatch = std::shared_ptr<std::vector<std::unique_ptr<Component>>>;
+Q_DECLARE_METATYPE(ComponentBatch)
+
+/**
+ * @brief Streams the inventory table from a worker thread
+ *
+ * The loader opens its own read-only connection to the database file and
+ * hydrates components with a copy of the category registry, so it never
+ * touches DatabaseManager's connection. The first batch is sized to fill
+ * one screen and is delivered as soon as it is ready; the rest follows in
+ * larger batches, built on the thread pool by a ParallelHydrator.
+ * Interrupting the thread stops the load between rows. The query's timings
+ * go to the given QueryStats, which must outlive the loader.
+ */
+class ComponentLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    ComponentLoader(const QString &databasePath, const CategoryRegistry &registry, QueryStats &stats,
+                    int firstBatchSize, int batchSize = DEFAULT_BATCH_SIZE);
+
+    static constexpr int DEFAULT_BATCH_SIZE = 500;
+
+public slots:
+    void run();
+
+signals:
+    void batchLoaded(ComponentBatch batch);
+    void finished(int componentCount);
+    void failed(const QString &message);
+
+private:
+    bool load(class QSqlDatabase &database);
+
+    QString m_databasePath;
+    CategoryRegistry m_registry;
+    QueryStats &m_stats;
+    int m_firstBatchSize;
+    int m_batchSize;
+    int m_loaded;
+};
+
+#endif // COMPONENTLOADER_H
@@ -0,0 +1,457 @@
+#include "database/CsvImporter.h"
+#include "database/DatabaseManager.h"
+#include "utils/SiValue.h"
+#include "utils/Trace.h"
+#include <QFile>
+#include <QHash>
+#include <QThreadPool>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <future>
+
+namespace
+{
+    enum Column
+    {
+        ColName,
+        ColCategory,
+        ColManufacturer,
+        ColQuantity,
+        ColMinStock,
+        ColValue,
+        ColUnit,
+        ColPackage,
+        ColVoltage,
+        ColPins,
+        ColDatasheet,
+        ColumnCount
+    };
+
+    /// Field index of each known column, -1 when the file doesn't have it
+    using ColumnMap = std::array<int, ColumnCount>;
+
+    struct ParsedChunk
+    {
+        std::vector<std::unique_ptr<Component>> components;
+        std::vector<CsvImporter::RowError> errors;
+        qint64 rows = 0;
+    };
+
+    int columnFor(const QString &header)
+    {
+        static const QHash<QString, int> aliases = {
+            {"name", ColName}, {"part", ColName}, {"part number", ColName},
+            {"category", ColCategory}, {"type", ColCategory},
+            {"manufacturer", ColManufacturer},
+            {"quantity", ColQuantity}, {"qty", ColQuantity},
+            {"min_stock", ColMinStock}, {"min stock", ColMinStock}, {"minstock", ColMinStock},
+            {"value", ColValue},
+            {"unit", ColUnit},
+            {"package", ColPackage},
+            {"voltage", ColVoltage},
+            {"pins", ColPins},
+            {"datasheet", ColDatasheet}};
+        return aliases.value(header.trimmed().toLower(), -1);
+    }
+
+    /**
+     * Parse one RFC 4180 record starting at p; quoted fields may contain
+     * delimiters, doubled quotes and line breaks.
+     * @return Pointer past the record's line break
+     */
+    const char *parseRecord(const char *p, const char *end, char delimiter, std::vector<QString> &fields, qint64 &lines)
+    {
+        fields.clear();
+        lines = 1;
+        QByteArray quoted;
+        while (true)
+        {
+            if (p < end && *p == '"')
+            {
+                quoted.clear();
+                ++p;
+                while (p < end)
+                {
+                    if (*p == '"')
+                    {
+                        if (p + 1 < end && p[1] == '"')
+                        {
+                            quoted += '"';
+                            p += 2;
+                            continue;
+                        }
+                        ++p;
+                        break;
+                    }
+                    if (*p == '\n')
+                        ++lines;
+                    quoted += *p++;
+                }
+                // Tolerate stray text between the closing quote and the delimiter
+                const char *start = p;
+                while (p < end && *p != delimiter && *p != '\n' && *p != '\r')
+                    ++p;
+                quoted.append(start, p - start);
+                fields.push_back(QString::fromUtf8(quoted));
+            }
+            else
+            {
+                const char *start = p;
+                while (p < end && *p != delimiter && *p != '\n' && *p != '\r')
+                    ++p;
+                fields.push_back(QString::fromUtf8(start, p - start));
+            }
+
+            if (p < end && *p == delimiter)
+            {
+                ++p;
+                continue;
+            }
+            if (p < end && *p == '\r')
+                ++p;
+            if (p < end && *p == '\n')
+                ++p;
+            return p;
+        }
+    }
+
+    /**
+     * Advance over up to records whole records without decoding them; cheap
+     * enough to run serially. Records end exactly where parseRecord ends them,
+     * and lines grows by what parseRecord would report for each.
+     */
+    const char *skipRecords(const char *p, const char *end, char delimiter, int records, qint64 &lines)
+    {
+        while (p < end && records > 0)
+        {
+            ++lines;
+            while (true)
+            {
+                // Only a quote at the start of a field opens a quoted field
+                if (p < end && *p == '"')
+                {
+                    ++p;
+                    while (p < end)
+                    {
+                        if (*p == '"')
+                        {
+                            if (p + 1 < end && p[1] == '"')
+                            {
+                                p += 2;
+                                continue;
+                            }
+                            ++p;
+                            break;
+                        }
+                        if (*p == '\n')
+                            ++lines;
+                        ++p;
+                    }
+                }
+                while (p < end && *p != delimiter && *p != '\n' && *p != '\r')
+                    ++p;
+
+                if (p < end && *p == delimiter)
+                {
+                    ++p;
+                    continue;
+                }
+                if (p < end && *p == '\r')
+                    ++p;
+                if (p < end && *p == '\n')
+                    ++p;
+                break;
+            }
+            --records;
+        }
+        return p;
+    }
+
+    char detectDelimiter(const char *line, const char *end)
+    {
+        const char *lineEnd = std::find(line, end, '\n');
+        qint64 tabs = std::count(line, lineEnd, '\t');
+        qint64 semicolons = std::count(line, lineEnd, ';');
+        qint64 commas = std::count(line, lineEnd, ',');
+        if (tabs > 0 && tabs >= commas && tabs >= semicolons)
+            return '\t';
+        if (semicolons > commas)
+            return ';';
+        return ',';
+    }
+
+    QString field(const std::vector<QString> &fields, const ColumnMap &columns, int column)
+    {
+        int index = columns[column];
+        return index >= 0 && index < static_cast<int>(fields.size()) ? fields[index].trimmed() : QString();
+    }
+
+    /// Empty text gives fallback; anything but a non-negative integer is an error
+    bool parseCount(const QString &text, int fallback, int &value)
+    {
+        if (text.isEmpty())
+        {
+            value = fallback;
+            return true;
+        }
+        bool ok = false;
+        value = text.toInt(&ok);
+        return ok && value >= 0;
+    }
+
+    std::unique_ptr<Component> buildComponent(const std::vector<QString> &fields, const ColumnMap &columns,
+                                              const CategoryRegistry &registry, QString &error)
+    {
+        QString name = field(fields, columns, ColName);
+        QString category = field(fields, columns, ColCategory);
+        if (name.isEmpty())
+        {
+            error = "Missing name";
+            return nullptr;
+        }
+
+        int slot = registry.slotOf(category);
+        if (slot == CategoryRegistry::UNKNOWN_SLOT)
+        {
+            error = QString("Unknown category '%1'").arg(category);
+            return nullptr;
+        }
+        const CategoryInfo &info = registry.categoryAt(slot);
+
+        int quantity = 0;
+        if (!parseCount(field(fields, columns, ColQuantity), 0, quantity))
+        {
+            error = QString("Invalid quantity '%1'").arg(field(fields, columns, ColQuantity));
+            return nullptr;
+        }
+        int minStock = -1;
+        if (!parseCount(field(fields, columns, ColMinStock), -1, minStock))
+        {
+            error = QString("Invalid min_stock '%1'").arg(field(fields, columns, ColMinStock));
+            return nullptr;
+        }
+
+        QString manufacturer = field(fields, columns, ColManufacturer);
+        std::unique_ptr<Component> component;
+        if (info.isActive())
+        {
+            double voltage = 0.0;
+            QString voltageText = field(fields, columns, ColVoltage);
+            if (!voltageText.isEmpty() && !SiValue::parse(voltageText, voltage))
+            {
+                error = QString("Invalid voltage '%1'").arg(voltageText);
+                return nullptr;
+            }
+            int pins = 0;
+            if (!parseCount(field(fields, columns, ColPins), 0, pins))
+            {
+                error = QString("Invalid pin count '%1'").arg(field(fields, columns, ColPins));
+                return nullptr;
+            }
+            component = std::make_unique<ActiveComponent>(-1, name, manufacturer, quantity, category,
+                                                          voltage, pins, field(fields, columns, ColDatasheet));
+        }
+        else
+        {
+            // Accepts "4k7", "100nF" or "10 kΩ"; a unit typed with the value wins over the category default
+            double value = 0.0;
+            QStringView parsedUnit;
+            QString valueText = field(fields, columns, ColValue);
+            if (!valueText.isEmpty() && !SiValue::parse(valueText, value, &parsedUnit))
+            {
+                error = QString("Invalid value '%1'").arg(valueText);
+                return nullptr;
+            }
+            QString unit = field(fields, columns, ColUnit);
+            if (unit.isEmpty())
+                unit = parsedUnit.isEmpty() ? info.defaultUnit() : parsedUnit.toString();
+
+            component = std::make_unique<PassiveComponent>(-1, name, manufacturer, quantity, category,
+                                                           value, unit, field(fields, columns, ColPackage));
+        }
+        component->setMinStock(minStock);
+        return component;
+    }
+
+    ParsedChunk parseChunk(const char *begin, const char *end, qint64 firstLine, char delimiter,
+                           const ColumnMap &columns, const CategoryRegistry &registry, const std::atomic<bool> &cancelled)
+    {
+        TRACE_SCOPE("import", "CsvImporter::parseChunk");
+        ParsedChunk chunk;
+        std::vector<QString> fields;
+        qint64 line = firstLine;
+        const char *p = begin;
+        while (p < end && !cancelled.load(std::memory_order_relaxed))
+        {
+            qint64 lines = 0;
+            p = parseRecord(p, end, delimiter, fields, lines);
+            qint64 recordLine = line;
+            line += lines;
+
+            if (fields.size() == 1 && fields[0].trimmed().isEmpty())
+                continue; // Blank line
+
+            ++chunk.rows;
+            QString error;
+            if (auto component = buildComponent(fields, columns, registry, error))
+                chunk.components.push_back(std::move(component));
+            else
+                chunk.errors.push_back({recordLine, error});
+        }
+        return chunk;
+    }
+}
+
+CsvImporter::CsvImporter(DatabaseManager &database, QObject *parent)
+    : QObject(parent), m_database(database), m_delimiter(0), m_chunkRows(DEFAULT_CHUNK_ROWS), m_cancelled(false)
+{
+}
+
+CsvImporter::Result CsvImporter::importFile(const QString &path)
+{
+    TRACE_SCOPE("import", "CsvImporter::importFile");
+    Result result;
+    m_cancelled = false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        result.error = QString("Cannot open %1: %2").arg(path, file.errorString());
+        return result;
+    }
+
+    // Pipes and special files can't be mapped; read those into memory instead
+    QByteArray buffer;
+    const qint64 size = file.size();
+    const char *data = size > 0 ? reinterpret_cast<const char *>(file.map(0, size)) : nullptr;
+    const bool mapped = data != nullptr;
+    if (!mapped)
+    {
+        buffer = file.readAll();
+        data = buffer.constData();
+    }
+    const char *end = data + (mapped ? size : buffer.size());
+    const qint64 total = end - data;
+
+    const char *p = data;
+    if (total >= 3 && std::equal(p, p + 3, "\xEF\xBB\xBF"))
+        p += 3; // UTF-8 byte order mark
+
+    // Header
+    char delimiter = m_delimiter ? m_delimiter : detectDelimiter(p, end);
+    std::vector<QString> headers;
+    qint64 line = 1;
+    qint64 headerLines = 0;
+    p = parseRecord(p, end, delimiter, headers, headerLines);
+    line += headerLines;
+
+    ColumnMap columns;
+    columns.fill(-1);
+    for (int i = 0; i < static_cast<int>(headers.size()); ++i)
+    {
+        int column = columnFor(headers[i]);
+        if (column >= 0 && columns[column] < 0)
+            columns[column] = i;
+    }
+    if (columns[ColName] < 0 || columns[ColCategory] < 0)
+    {
+        result.error = "The header must name a 'name' and a 'category' column";
+        return result;
+    }
+
+    // Workers read the mapping and this registry copy; both outlive every task below
+    const CategoryRegistry registry = m_database.categoryRegistry();
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxInFlight = qMax(2, pool->maxThreadCount() * 2);
+    std::deque<std::future<ParsedChunk>> inFlight;
+    std::deque<const char *> chunkEnds;
+
+    auto submitChunks = [&]()
+    {
+        while (p < end && static_cast<int>(inFlight.size()) < maxInFlight)
+        {
+            const char *chunkBegin = p;
+            qint64 firstLine = line;
+            p = skipRecords(p, end, delimiter, m_chunkRows, line);
+
+            auto task = std::make_shared<std::packaged_task<ParsedChunk()>>(
+                [=, &columns, &registry]()
+                { return parseChunk(chunkBegin, p, firstLine, delimiter, columns, registry, m_cancelled); });
+            inFlight.push_back(task->get_future());
+            chunkEnds.push_back(p);
+            pool->start([task]()
+                        { (*task)(); });
+        }
+    };
+
+    bool ok = m_database.beginTransaction();
+    if (ok)
+    {
+        submitChunks();
+    }
+    else
+    {
+        result.error = m_database.lastError().text();
+    }
+
+    while (ok && !inFlight.empty())
+    {
+        ParsedChunk chunk = inFlight.front().get();
+        inFlight.pop_front();
+        const char *chunkEnd = chunkEnds.front();
+        chunkEnds.pop_front();
+
+        // Keep the workers busy while this thread inserts
+        submitChunks();
+
+        if (m_cancelled)
+        {
+            ok = false;
+            result.cancelled = true;
+            result.error = "Import cancelled";
+            break;
+        }
+
+        result.rows += chunk.rows;
+        result.errorCount += static_cast<qint64>(chunk.errors.size());
+        for (RowError &error : chunk.errors)
+        {
+            if (static_cast<int>(result.errors.size()) >= MAX_REPORTED_ERRORS)
+                break;
+            result.errors.push_back(std::move(error));
+        }
+
+        if (m_database.addComponents(chunk.components) < 0)
+        {
+            ok = false;
+            result.error = m_database.lastError().text();
+            break;
+        }
+        result.imported += static_cast<qint64>(chunk.components.size());
+
+        emit progress(chunkEnd - data, total);
+    }
+
+    // Tasks still running read the mapping, so they must finish before it goes away
+    m_cancelled = m_cancelled || !ok;
+    for (auto &future : inFlight)
+    {
+        future.wait();
+    }
+
+    if (ok)
+    {
+        ok = m_database.commitTransaction();
+        if (!ok)
+            result.error = m_database.lastError().text();
+    }
+    else
+    {
+        m_database.rollbackTransaction();
+        result.imported = 0;
+    }
+
+    result.ok = ok;
+    return result;
+}
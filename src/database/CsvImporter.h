@@ -0,0 +1,76 @@
+#ifndef CSVIMPORTER_H
+#define CSVIMPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <vector>
+
+class DatabaseManager;
+
+/**
+ * @brief Imports components from a CSV or TSV file
+ *
+ * The file is memory-mapped and cut into chunks of whole records. Worker
+ * threads from the global QThreadPool parse and validate the chunks in
+ * parallel: SI values such as "4k7" or "100nF", quantities, and category
+ * names against a snapshot of the category registry. The calling thread
+ * inserts the parsed chunks in file order through
+ * DatabaseManager::addComponents, all inside one transaction, so a failed
+ * or cancelled import leaves the database unchanged.
+ *
+ * The first line names the columns (case-insensitive, any order): name,
+ * category (or type), manufacturer, quantity, min_stock, and value, unit,
+ * package for passive parts or voltage, pins, datasheet for active ones.
+ * Invalid rows are skipped and reported with their line number.
+ *
+ * Must be called on the thread that owns DatabaseManager's connection.
+ */
+class CsvImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct RowError
+    {
+        qint64 line; ///< 1-based line in the file
+        QString message;
+    };
+
+    struct Result
+    {
+        bool ok = false;
+        bool cancelled = false;
+        qint64 rows = 0; ///< Data rows read, excluding the header and blank lines
+        qint64 imported = 0;
+        qint64 errorCount = 0;
+        std::vector<RowError> errors; ///< The first MAX_REPORTED_ERRORS, in file order
+        QString error;                ///< Why nothing was imported, when !ok
+    };
+
+    static constexpr int DEFAULT_CHUNK_ROWS = 5000;
+    static constexpr int MAX_REPORTED_ERRORS = 1000;
+
+    explicit CsvImporter(DatabaseManager &database, QObject *parent = nullptr);
+
+    /// Field separator; 0 picks tab, semicolon or comma from the header line
+    void setDelimiter(char delimiter) { m_delimiter = delimiter; }
+    void setChunkRows(int rows) { m_chunkRows = qMax(1, rows); }
+
+    Result importFile(const QString &path);
+
+public slots:
+    /// Safe to call from any thread, or from a progress handler
+    void cancel() { m_cancelled = true; }
+
+signals:
+    void progress(qint64 bytesProcessed, qint64 bytesTotal);
+
+private:
+    DatabaseManager &m_database;
+    char m_delimiter;
+    int m_chunkRows;
+    std::atomic<bool> m_cancelled;
+};
+
+#endif // CSVIMPORTER_H
@@ -1,9 +1,69 @@
 #include "database/DatabaseManager.h"
+#include "database/NativeRowReader.h"
+#include "database/ParallelHydrator.h"
+#include "config/AppConfig.h"
+#include "utils/Trace.h"
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QVariant>
 #include <QDebug>
 #include <QFileInfo>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    /// Bind -1 ("not set") as SQL NULL
+    QVariant nullableInt(int value)
+    {
+        return value >= 0 ? QVariant(value) : QVariant(QMetaType::fromType<int>());
+    }
+
+    const char *const INSERT_COMPONENT_SQL = R"(
+        INSERT INTO inventory (name, manufacturer, type, quantity, param_1, param_2, extra_data, min_stock)
+        VALUES (:name, :manufacturer, :type, :quantity, :param_1, :param_2, :extra_data, :min_stock)
+    )";
+
+    /// Bind every inventory column except id
+    void bindComponent(QSqlQuery &query, const Component *component)
+    {
+        query.bindValue(":name", component->getName());
+        query.bindValue(":manufacturer", component->getManufacturer());
+        query.bindValue(":type", component->getType());
+        query.bindValue(":quantity", component->getQuantity());
+        query.bindValue(":param_1", component->getParam1());
+        query.bindValue(":param_2", component->getParam2());
+
+        // Store additional data for passive/active components
+        QString extraData;
+        if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
+        {
+            extraData = passive->getUnit();
+        }
+        else if (auto *active = dynamic_cast<const ActiveComponent *>(component))
+        {
+            extraData = active->getDatasheetLink();
+        }
+        query.bindValue(":extra_data", extraData);
+        query.bindValue(":min_stock", nullableInt(component->getMinStock()));
+    }
+
+    int intOrUnset(const QVariant &value)
+    {
+        return value.isNull() ? -1 : value.toInt();
+    }
+
+    CategoryInfo categoryFromQuery(const QSqlQuery &query)
+    {
+        return CategoryInfo(
+            query.value("id").toInt(),
+            query.value("name").toString(),
+            query.value("is_passive").toBool(),
+            query.value("is_active").toBool(),
+            query.value("default_unit").toString(),
+            intOrUnset(query.value("low_stock_threshold")));
+    }
+}
 
 DatabaseManager &DatabaseManager::instance()
 {
@@ -12,21 +72,46 @@ DatabaseManager &DatabaseManager::instance()
 }
 
 DatabaseManager::DatabaseManager()
-    : QObject(nullptr), m_connectionName("ElectraBaseConnection")
+    : QObject(nullptr), m_connectionName("ElectraBaseConnection"), m_transactionDepth(0), m_dataChangedPending(false),
+      m_nativeReadsEnabled(true)
 {
+    m_queryStats.setSlowThresholdMs(AppConfig::instance().settings()->slowQueryMs);
+
+    connect(&AppConfig::instance(), &AppConfig::configChanged, this, [this](AppConfig::ChangedFields fields)
+            {
+                auto settings = AppConfig::instance().settings();
+                if (fields & AppConfig::LowStockThresholdChanged)
+                {
+                    m_categoryRegistry.setDefaultThreshold(settings->lowStockThreshold);
+                }
+                if (fields & AppConfig::DiagnosticsChanged)
+                {
+                    m_queryStats.setSlowThresholdMs(settings->slowQueryMs);
+                }
+            });
 }
 
 DatabaseManager::~DatabaseManager()
+{
+    close();
+}
+
+void DatabaseManager::close()
 {
     if (m_database.isOpen())
     {
         m_database.close();
     }
+    // The handle must be released before the connection can be removed
+    m_database = QSqlDatabase();
+    m_transactionDepth = 0;
+    m_dataChangedPending = false;
     QSqlDatabase::removeDatabase(m_connectionName);
 }
 
 bool DatabaseManager::initialize(const QString &dbPath)
 {
+    TRACE_SCOPE("db", "DatabaseManager::initialize");
     if (QSqlDatabase::contains(m_connectionName))
     {
         m_database = QSqlDatabase::database(m_connectionName);
@@ -49,6 +134,13 @@ bool DatabaseManager::initialize(const QString &dbPath)
 
     qDebug() << "Database opened successfully:" << dbPath;
 
+    // WAL lets the background loader read while this connection writes
+    TimedQuery journalQuery(m_database, m_queryStats);
+    if (!journalQuery.exec("PRAGMA journal_mode=WAL"))
+    {
+        qWarning() << "Could not enable WAL journal mode:" << journalQuery.lastError().text();
+    }
+
     // Create tables if they don't exist
     if (!createTables())
     {
@@ -61,6 +153,7 @@ bool DatabaseManager::initialize(const QString &dbPath)
         return false;
     }
 
+    reloadCategoryRegistry();
     return true;
 }
 
@@ -74,9 +167,91 @@ QSqlError DatabaseManager::lastError() const
     return m_lastError;
 }
 
+bool DatabaseManager::beginTransaction()
+{
+    if (m_transactionDepth == 0 && !m_database.transaction())
+    {
+        m_lastError = m_database.lastError();
+        emit errorOccurred(QString("Failed to start transaction: %1").arg(m_lastError.text()));
+        return false;
+    }
+    ++m_transactionDepth;
+    return true;
+}
+
+bool DatabaseManager::commitTransaction()
+{
+    if (m_transactionDepth == 0)
+    {
+        // Already rolled back by a nested failure
+        return false;
+    }
+    if (--m_transactionDepth > 0)
+    {
+        return true;
+    }
+
+    bool changed = m_dataChangedPending;
+    m_dataChangedPending = false;
+    if (!m_database.commit())
+    {
+        m_lastError = m_database.lastError();
+        m_database.rollback();
+        emit errorOccurred(QString("Failed to commit transaction: %1").arg(m_lastError.text()));
+        return false;
+    }
+
+    if (changed)
+    {
+        emit dataChanged();
+    }
+    return true;
+}
+
+void DatabaseManager::rollbackTransaction()
+{
+    if (m_transactionDepth == 0)
+    {
+        return;
+    }
+    m_transactionDepth = 0;
+    m_dataChangedPending = false;
+    m_database.rollback();
+}
+
+void DatabaseManager::notifyDataChanged()
+{
+    // Inside a transaction listeners hear about it once, after the commit
+    if (m_transactionDepth > 0)
+    {
+        m_dataChangedPending = true;
+        return;
+    }
+    emit dataChanged();
+}
+
+bool DatabaseManager::vacuum()
+{
+    TRACE_SCOPE("db", "DatabaseManager::vacuum");
+    if (m_transactionDepth > 0)
+    {
+        emit errorOccurred("Cannot vacuum inside a transaction");
+        return false;
+    }
+
+    TimedQuery query(m_database, m_queryStats);
+    if (!query.exec("VACUUM") || !query.exec("PRAGMA optimize"))
+    {
+        m_lastError = query.lastError();
+        emit errorOccurred(QString("Failed to vacuum database: %1").arg(m_lastError.text()));
+        return false;
+    }
+    return true;
+}
+
 bool DatabaseManager::createTables()
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
 
     // Create inventory table
     const QString createTableSQL = R"(
@@ -88,7 +263,8 @@ bool DatabaseManager::createTables()
             quantity INTEGER DEFAULT 0,
             param_1 REAL,
             param_2 TEXT,
-            extra_data TEXT
+            extra_data TEXT,
+            min_stock INTEGER
         )
     )";
 
@@ -99,6 +275,12 @@ bool DatabaseManager::createTables()
         return false;
     }
 
+    // Databases created before per-component reorder points
+    if (!ensureColumn("inventory", "min_stock", "INTEGER"))
+    {
+        return false;
+    }
+
     // Create index for faster searches
     query.exec("CREATE INDEX IF NOT EXISTS idx_name ON inventory(name)");
     query.exec("CREATE INDEX IF NOT EXISTS idx_type ON inventory(type)");
@@ -110,7 +292,7 @@ bool DatabaseManager::createTables()
 
 bool DatabaseManager::createCategoriesTable()
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
 
     const QString createCategoriesSQL = R"(
         CREATE TABLE IF NOT EXISTS categories (
@@ -119,7 +301,8 @@ bool DatabaseManager::createCategoriesTable()
             is_passive INTEGER DEFAULT 0,
             is_active INTEGER DEFAULT 0,
             default_unit TEXT,
-            is_system INTEGER DEFAULT 0
+            is_system INTEGER DEFAULT 0,
+            low_stock_threshold INTEGER
         )
     )";
 
@@ -130,6 +313,12 @@ bool DatabaseManager::createCategoriesTable()
         return false;
     }
 
+    // Databases created before per-category thresholds
+    if (!ensureColumn("categories", "low_stock_threshold", "INTEGER"))
+    {
+        return false;
+    }
+
     query.exec("SELECT COUNT(*) FROM categories");
     if (query.next() && query.value(0).toInt() == 0)
     {
@@ -162,7 +351,7 @@ bool DatabaseManager::populateDefaultCategories()
         {"Connector", false, false, "", true},
         {"Other", false, false, "", true}};
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare(R"(
         INSERT INTO categories (name, is_passive, is_active, default_unit, is_system)
         VALUES (:name, :is_passive, :is_active, :default_unit, :is_system)
@@ -187,13 +376,47 @@ bool DatabaseManager::populateDefaultCategories()
     return true;
 }
 
+bool DatabaseManager::ensureColumn(const QString &table, const QString &column, const QString &definition)
+{
+    TimedQuery query(m_database, m_queryStats);
+    if (!query.exec(QString("PRAGMA table_info(%1)").arg(table)))
+    {
+        m_lastError = query.lastError();
+        return false;
+    }
+
+    while (query.next())
+    {
+        if (query.value("name").toString() == column)
+        {
+            return true;
+        }
+    }
+
+    if (!query.exec(QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(table, column, definition)))
+    {
+        m_lastError = query.lastError();
+        emit errorOccurred(QString("Failed to add column %1.%2: %3").arg(table, column, m_lastError.text()));
+        return false;
+    }
+
+    qDebug() << "Added column" << column << "to" << table;
+    return true;
+}
+
+void DatabaseManager::reloadCategoryRegistry()
+{
+    m_categoryRegistry.rebuild(fetchAllCategories(), AppConfig::instance().settings()->lowStockThreshold);
+}
+
 // ==================== Categories ====================
 
 std::vector<CategoryInfo> DatabaseManager::fetchAllCategories()
 {
+    TRACE_SCOPE("db", "DatabaseManager::fetchAllCategories");
     std::vector<CategoryInfo> categories;
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     if (!query.exec("SELECT * FROM categories ORDER BY id"))
     {
         m_lastError = query.lastError();
@@ -202,13 +425,7 @@ std::vector<CategoryInfo> DatabaseManager::fetchAllCategories()
 
     while (query.next())
     {
-        CategoryInfo cat(
-            query.value("id").toInt(),
-            query.value("name").toString(),
-            query.value("is_passive").toBool(),
-            query.value("is_active").toBool(),
-            query.value("default_unit").toString());
-        categories.push_back(cat);
+        categories.push_back(categoryFromQuery(query));
     }
 
     return categories;
@@ -216,7 +433,7 @@ std::vector<CategoryInfo> DatabaseManager::fetchAllCategories()
 
 CategoryInfo DatabaseManager::fetchCategory(int id)
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT * FROM categories WHERE id = :id");
     query.bindValue(":id", id);
 
@@ -225,17 +442,12 @@ CategoryInfo DatabaseManager::fetchCategory(int id)
         return CategoryInfo();
     }
 
-    return CategoryInfo(
-        query.value("id").toInt(),
-        query.value("name").toString(),
-        query.value("is_passive").toBool(),
-        query.value("is_active").toBool(),
-        query.value("default_unit").toString());
+    return categoryFromQuery(query);
 }
 
 CategoryInfo DatabaseManager::fetchCategoryByName(const QString &name)
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT * FROM categories WHERE name = :name");
     query.bindValue(":name", name);
 
@@ -244,26 +456,23 @@ CategoryInfo DatabaseManager::fetchCategoryByName(const QString &name)
         return CategoryInfo();
     }
 
-    return CategoryInfo(
-        query.value("id").toInt(),
-        query.value("name").toString(),
-        query.value("is_passive").toBool(),
-        query.value("is_active").toBool(),
-        query.value("default_unit").toString());
+    return categoryFromQuery(query);
 }
 
 int DatabaseManager::addCategory(const CategoryInfo &category)
 {
-    QSqlQuery query(m_database);
+    TRACE_SCOPE("db", "DatabaseManager::addCategory");
+    TimedQuery query(m_database, m_queryStats);
     query.prepare(R"(
-        INSERT INTO categories (name, is_passive, is_active, default_unit, is_system)
-        VALUES (:name, :is_passive, :is_active, :default_unit, 0)
+        INSERT INTO categories (name, is_passive, is_active, default_unit, is_system, low_stock_threshold)
+        VALUES (:name, :is_passive, :is_active, :default_unit, 0, :low_stock_threshold)
     )");
 
     query.bindValue(":name", category.name());
     query.bindValue(":is_passive", category.isPassive() ? 1 : 0);
     query.bindValue(":is_active", category.isActive() ? 1 : 0);
     query.bindValue(":default_unit", category.defaultUnit());
+    query.bindValue(":low_stock_threshold", nullableInt(category.lowStockThreshold()));
 
     if (!query.exec())
     {
@@ -273,20 +482,23 @@ int DatabaseManager::addCategory(const CategoryInfo &category)
     }
 
     int newId = query.lastInsertId().toInt();
+    reloadCategoryRegistry();
     emit categoriesChanged();
     return newId;
 }
 
 bool DatabaseManager::updateCategory(const CategoryInfo &category)
 {
+    TRACE_SCOPE("db", "DatabaseManager::updateCategory");
     if (category.id() < 0)
         return false;
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare(R"(
         UPDATE categories
         SET name = :name, is_passive = :is_passive,
-            is_active = :is_active, default_unit = :default_unit
+            is_active = :is_active, default_unit = :default_unit,
+            low_stock_threshold = :low_stock_threshold
         WHERE id = :id
     )");
 
@@ -295,6 +507,7 @@ bool DatabaseManager::updateCategory(const CategoryInfo &category)
     query.bindValue(":is_passive", category.isPassive() ? 1 : 0);
     query.bindValue(":is_active", category.isActive() ? 1 : 0);
     query.bindValue(":default_unit", category.defaultUnit());
+    query.bindValue(":low_stock_threshold", nullableInt(category.lowStockThreshold()));
 
     if (!query.exec())
     {
@@ -303,12 +516,14 @@ bool DatabaseManager::updateCategory(const CategoryInfo &category)
         return false;
     }
 
+    reloadCategoryRegistry();
     emit categoriesChanged();
     return true;
 }
 
 bool DatabaseManager::deleteCategory(int id)
 {
+    TRACE_SCOPE("db", "DatabaseManager::deleteCategory");
     if (!canDeleteCategory(id))
     {
         emit errorOccurred("Cannot delete system categories");
@@ -321,7 +536,7 @@ bool DatabaseManager::deleteCategory(int id)
         return false;
 
     // Move components with this category to "Other"
-    QSqlQuery updateQuery(m_database);
+    TimedQuery updateQuery(m_database, m_queryStats);
     updateQuery.prepare("UPDATE inventory SET type = 'Other' WHERE type = :type");
     updateQuery.bindValue(":type", cat.name());
 
@@ -339,7 +554,7 @@ bool DatabaseManager::deleteCategory(int id)
     }
 
     // Delete the category
-    QSqlQuery deleteQuery(m_database);
+    TimedQuery deleteQuery(m_database, m_queryStats);
     deleteQuery.prepare("DELETE FROM categories WHERE id = :id");
     deleteQuery.bindValue(":id", id);
 
@@ -350,17 +565,18 @@ bool DatabaseManager::deleteCategory(int id)
         return false;
     }
 
+    reloadCategoryRegistry();
     emit categoriesChanged();
     if (movedCount > 0)
     {
-        emit dataChanged();
+        notifyDataChanged();
     }
     return true;
 }
 
 bool DatabaseManager::canDeleteCategory(int id)
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT is_system FROM categories WHERE id = :id");
     query.bindValue(":id", id);
 
@@ -374,7 +590,7 @@ bool DatabaseManager::canDeleteCategory(int id)
 
 int DatabaseManager::getComponentCountForCategory(const QString &categoryName)
 {
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT COUNT(*) FROM inventory WHERE type = :type");
     query.bindValue(":type", categoryName);
 
@@ -401,33 +617,13 @@ int DatabaseManager::getComponentCountForCategory(int categoryId)
 
 int DatabaseManager::addComponent(const Component *component)
 {
+    TRACE_SCOPE("db", "DatabaseManager::addComponent");
     if (!component)
         return -1;
 
-    QSqlQuery query(m_database);
-    query.prepare(R"(
-        INSERT INTO inventory (name, manufacturer, type, quantity, param_1, param_2, extra_data)
-        VALUES (:name, :manufacturer, :type, :quantity, :param_1, :param_2, :extra_data)
-    )");
-
-    query.bindValue(":name", component->getName());
-    query.bindValue(":manufacturer", component->getManufacturer());
-    query.bindValue(":type", component->getType());
-    query.bindValue(":quantity", component->getQuantity());
-    query.bindValue(":param_1", component->getParam1());
-    query.bindValue(":param_2", component->getParam2());
-
-    // Store additional data for passive/active components
-    QString extraData;
-    if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
-    {
-        extraData = passive->getUnit();
-    }
-    else if (auto *active = dynamic_cast<const ActiveComponent *>(component))
-    {
-        extraData = active->getDatasheetLink();
-    }
-    query.bindValue(":extra_data", extraData);
+    TimedQuery query(m_database, m_queryStats);
+    query.prepare(INSERT_COMPONENT_SQL);
+    bindComponent(query, component);
 
     if (!query.exec())
     {
@@ -437,42 +633,60 @@ int DatabaseManager::addComponent(const Component *component)
     }
 
     int newId = query.lastInsertId().toInt();
-    emit dataChanged();
+    notifyDataChanged();
     return newId;
 }
 
+int DatabaseManager::addComponents(const std::vector<std::unique_ptr<Component>> &components)
+{
+    TRACE_SCOPE("db", "DatabaseManager::addComponents");
+    if (components.empty())
+        return 0;
+
+    if (!beginTransaction())
+        return -1;
+
+    {
+        TimedQuery query(m_database, m_queryStats);
+        query.prepare(INSERT_COMPONENT_SQL);
+        for (const auto &component : components)
+        {
+            bindComponent(query, component.get());
+            if (!query.exec())
+            {
+                m_lastError = query.lastError();
+                query.finish();
+                rollbackTransaction();
+                emit errorOccurred(QString("Failed to add components: %1").arg(m_lastError.text()));
+                return -1;
+            }
+        }
+    }
+
+    if (!commitTransaction())
+        return -1;
+
+    notifyDataChanged();
+    return static_cast<int>(components.size());
+}
+
 bool DatabaseManager::updateComponent(const Component *component)
 {
+    TRACE_SCOPE("db", "DatabaseManager::updateComponent");
     if (!component || component->getId() < 0)
         return false;
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare(R"(
         UPDATE inventory 
         SET name = :name, manufacturer = :manufacturer, type = :type,
             quantity = :quantity, param_1 = :param_1, param_2 = :param_2,
-            extra_data = :extra_data
+            extra_data = :extra_data, min_stock = :min_stock
         WHERE id = :id
     )");
 
     query.bindValue(":id", component->getId());
-    query.bindValue(":name", component->getName());
-    query.bindValue(":manufacturer", component->getManufacturer());
-    query.bindValue(":type", component->getType());
-    query.bindValue(":quantity", component->getQuantity());
-    query.bindValue(":param_1", component->getParam1());
-    query.bindValue(":param_2", component->getParam2());
-
-    QString extraData;
-    if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
-    {
-        extraData = passive->getUnit();
-    }
-    else if (auto *active = dynamic_cast<const ActiveComponent *>(component))
-    {
-        extraData = active->getDatasheetLink();
-    }
-    query.bindValue(":extra_data", extraData);
+    bindComponent(query, component);
 
     if (!query.exec())
     {
@@ -481,13 +695,14 @@ bool DatabaseManager::updateComponent(const Component *component)
         return false;
     }
 
-    emit dataChanged();
+    notifyDataChanged();
     return true;
 }
 
 bool DatabaseManager::deleteComponent(int id)
 {
-    QSqlQuery query(m_database);
+    TRACE_SCOPE("db", "DatabaseManager::deleteComponent");
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("DELETE FROM inventory WHERE id = :id");
     query.bindValue(":id", id);
 
@@ -498,53 +713,76 @@ bool DatabaseManager::deleteComponent(int id)
         return false;
     }
 
-    emit dataChanged();
+    notifyDataChanged();
     return true;
 }
 
-std::unique_ptr<Component> DatabaseManager::hydrateComponent(const QSqlQuery &query)
+std::unique_ptr<Component> DatabaseManager::hydrateComponent(const QSqlQuery &query, const CategoryRegistry &registry)
 {
-    int id = query.value("id").toInt();
-    QString name = query.value("name").toString();
-    QString manufacturer = query.value("manufacturer").toString();
-    QString type = query.value("type").toString();
-    int quantity = query.value("quantity").toInt();
-    double param1 = query.value("param_1").toDouble();
-    QString param2 = query.value("param_2").toString();
-    QString extraData = query.value("extra_data").toString();
+    ComponentRow row;
+    readComponentRow(query, row);
+    return buildComponent(row, registry);
+}
+
+void DatabaseManager::readComponentRow(const QSqlQuery &query, ComponentRow &row)
+{
+    row.id = query.value("id").toInt();
+    row.name = query.value("name").toString();
+    row.manufacturer = query.value("manufacturer").toString();
+    row.type = query.value("type").toString();
+    row.quantity = query.value("quantity").toInt();
+    row.param1 = query.value("param_1").toDouble();
+    row.param2 = query.value("param_2").toString();
+    row.extraData = query.value("extra_data").toString();
+    row.minStock = intOrUnset(query.value("min_stock"));
+}
 
-    // Look up category info from database
-    CategoryInfo catInfo = fetchCategoryByName(type);
+std::unique_ptr<Component> DatabaseManager::buildComponent(const ComponentRow &row, const CategoryRegistry &registry)
+{
+    // Look up category info from the in-memory registry
+    const CategoryInfo &catInfo = registry.categoryAt(registry.slotOf(row.type));
 
     // Instantiate correct derived class based on category type
+    std::unique_ptr<Component> component;
     if (catInfo.isPassive())
     {
-        return std::make_unique<PassiveComponent>(
-            id, name, manufacturer, quantity, type,
-            param1,    // value
-            extraData, // unit (stored in extra_data)
-            param2     // package
+        component = std::make_unique<PassiveComponent>(
+            row.id, row.name, row.manufacturer, row.quantity, row.type,
+            row.param1,    // value
+            row.extraData, // unit (stored in extra_data)
+            row.param2     // package
         );
     }
     else if (catInfo.isActive())
     {
-        return std::make_unique<ActiveComponent>(
-            id, name, manufacturer, quantity, type,
-            param1,         // operating voltage
-            param2.toInt(), // pin count
-            extraData       // datasheet link
+        component = std::make_unique<ActiveComponent>(
+            row.id, row.name, row.manufacturer, row.quantity, row.type,
+            row.param1,         // operating voltage
+            row.param2.toInt(), // pin count
+            row.extraData       // datasheet link
         );
     }
+    else
+    {
+        // For unknown types, create a passive component as fallback
+        component = std::make_unique<PassiveComponent>(
+            row.id, row.name, row.manufacturer, row.quantity, row.type,
+            row.param1, row.extraData, row.param2);
+    }
 
-    // For unknown types, create a passive component as fallback
-    return std::make_unique<PassiveComponent>(
-        id, name, manufacturer, quantity, type,
-        param1, extraData, param2);
+    component->setMinStock(row.minStock);
+    return component;
+}
+
+bool DatabaseManager::nativeReadsAvailable() const
+{
+    return NativeRowReader(m_database).isValid();
 }
 
 std::unique_ptr<Component> DatabaseManager::fetchComponent(int id)
 {
-    QSqlQuery query(m_database);
+    TRACE_SCOPE("db", "DatabaseManager::fetchComponent");
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT * FROM inventory WHERE id = :id");
     query.bindValue(":id", id);
 
@@ -553,15 +791,57 @@ std::unique_ptr<Component> DatabaseManager::fetchComponent(int id)
         return nullptr;
     }
 
-    return hydrateComponent(query);
+    return hydrateComponent(query, m_categoryRegistry);
 }
 
 std::vector<std::unique_ptr<Component>> DatabaseManager::fetchAllComponents()
 {
+    TRACE_SCOPE("db", "DatabaseManager::fetchAllComponents");
+    static const QString sql = "SELECT * FROM inventory ORDER BY name";
     std::vector<std::unique_ptr<Component>> components;
 
-    QSqlQuery query(m_database);
-    if (!query.exec("SELECT * FROM inventory ORDER BY name"))
+    // Rows are read on this thread and built on the thread pool
+    ParallelHydrator hydrator(m_categoryRegistry, [&components](ParallelHydrator::Block &&block)
+                              { std::move(block.begin(), block.end(), std::back_inserter(components)); });
+    ComponentRow row;
+
+    NativeRowReader reader(m_database);
+    if (m_nativeReadsEnabled && reader.isValid())
+    {
+        // Timed like TimedQuery, so the statement still shows up in the query stats
+        qint64 start = Trace::nowNs();
+        bool prepared = reader.prepare(sql);
+        const qint64 prepareNs = Trace::nowNs() - start;
+
+        qint64 stepNs = 0;
+        qint64 rows = 0;
+        while (prepared)
+        {
+            start = Trace::nowNs();
+            bool more = reader.next(row);
+            stepNs += Trace::nowNs() - start;
+            if (!more)
+            {
+                break;
+            }
+            ++rows;
+            hydrator.addRow(std::move(row));
+        }
+        m_queryStats.record(sql, prepareNs, 0, stepNs, rows);
+
+        if (reader.hasError())
+        {
+            m_lastError = QSqlError(reader.lastError(), QString(), QSqlError::StatementError);
+            emit errorOccurred(QString("Failed to fetch components: %1").arg(m_lastError.text()));
+            components.clear();
+            return components;
+        }
+        hydrator.finish();
+        return components;
+    }
+
+    TimedQuery query(m_database, m_queryStats);
+    if (!query.exec(sql))
     {
         m_lastError = query.lastError();
         emit errorOccurred(QString("Failed to fetch components: %1").arg(m_lastError.text()));
@@ -570,20 +850,20 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::fetchAllComponents()
 
     while (query.next())
     {
-        if (auto component = hydrateComponent(query))
-        {
-            components.push_back(std::move(component));
-        }
+        readComponentRow(query, row);
+        hydrator.addRow(std::move(row));
     }
+    hydrator.finish();
 
     return components;
 }
 
 std::vector<std::unique_ptr<Component>> DatabaseManager::fetchByCategory(const QString &categoryName)
 {
+    TRACE_SCOPE("db", "DatabaseManager::fetchByCategory");
     std::vector<std::unique_ptr<Component>> components;
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT * FROM inventory WHERE type = :type ORDER BY name");
     query.bindValue(":type", categoryName);
 
@@ -595,7 +875,7 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::fetchByCategory(const Q
 
     while (query.next())
     {
-        if (auto component = hydrateComponent(query))
+        if (auto component = hydrateComponent(query, m_categoryRegistry))
         {
             components.push_back(std::move(component));
         }
@@ -604,13 +884,20 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::fetchByCategory(const Q
     return components;
 }
 
-std::vector<std::unique_ptr<Component>> DatabaseManager::fetchLowStock(int threshold)
+std::vector<std::unique_ptr<Component>> DatabaseManager::fetchLowStock()
 {
+    TRACE_SCOPE("db", "DatabaseManager::fetchLowStock");
     std::vector<std::unique_ptr<Component>> components;
 
-    QSqlQuery query(m_database);
-    query.prepare("SELECT * FROM inventory WHERE quantity < :threshold ORDER BY quantity ASC");
-    query.bindValue(":threshold", threshold);
+    // categories.name is UNIQUE, so the join is an index lookup per row
+    TimedQuery query(m_database, m_queryStats);
+    query.prepare(R"(
+        SELECT i.* FROM inventory i
+        LEFT JOIN categories c ON c.name = i.type
+        WHERE i.quantity < COALESCE(i.min_stock, c.low_stock_threshold, :default_threshold)
+        ORDER BY i.quantity ASC
+    )");
+    query.bindValue(":default_threshold", AppConfig::instance().settings()->lowStockThreshold);
 
     if (!query.exec())
     {
@@ -620,7 +907,7 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::fetchLowStock(int thres
 
     while (query.next())
     {
-        if (auto component = hydrateComponent(query))
+        if (auto component = hydrateComponent(query, m_categoryRegistry))
         {
             components.push_back(std::move(component));
         }
@@ -629,11 +916,32 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::fetchLowStock(int thres
     return components;
 }
 
+int DatabaseManager::countLowStock()
+{
+    TRACE_SCOPE("db", "DatabaseManager::countLowStock");
+    TimedQuery query(m_database, m_queryStats);
+    query.prepare(R"(
+        SELECT COUNT(*) FROM inventory i
+        LEFT JOIN categories c ON c.name = i.type
+        WHERE i.quantity < COALESCE(i.min_stock, c.low_stock_threshold, :default_threshold)
+    )");
+    query.bindValue(":default_threshold", AppConfig::instance().settings()->lowStockThreshold);
+
+    if (!query.exec() || !query.next())
+    {
+        m_lastError = query.lastError();
+        return 0;
+    }
+
+    return query.value(0).toInt();
+}
+
 std::vector<std::unique_ptr<Component>> DatabaseManager::searchByName(const QString &searchTerm)
 {
+    TRACE_SCOPE("db", "DatabaseManager::searchByName");
     std::vector<std::unique_ptr<Component>> components;
 
-    QSqlQuery query(m_database);
+    TimedQuery query(m_database, m_queryStats);
     query.prepare("SELECT * FROM inventory WHERE name LIKE :term ORDER BY name");
     query.bindValue(":term", "%" + searchTerm + "%");
 
@@ -645,7 +953,7 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::searchByName(const QStr
 
     while (query.next())
     {
-        if (auto component = hydrateComponent(query))
+        if (auto component = hydrateComponent(query, m_categoryRegistry))
         {
             components.push_back(std::move(component));
         }
@@ -654,10 +962,114 @@ std::vector<std::unique_ptr<Component>> DatabaseManager::searchByName(const QStr
     return components;
 }
 
+int DatabaseManager::componentCount()
+{
+    TimedQuery query(m_database, m_queryStats);
+    if (!query.exec("SELECT COUNT(*) FROM inventory") || !query.next())
+    {
+        m_lastError = query.lastError();
+        return 0;
+    }
+    return query.value(0).toInt();
+}
+
+QString DatabaseManager::filteredComponentSql(const ComponentFilter &filter, bool countOnly)
+{
+    QString sql = countOnly ? "SELECT COUNT(*)" : "SELECT i.*";
+    sql += R"( FROM inventory i
+        LEFT JOIN categories c ON c.name = i.type
+        WHERE 1 = 1)";
+    if (!filter.category.isEmpty())
+        sql += " AND i.type = :type";
+    if (!filter.nameContains.isEmpty())
+        sql += " AND i.name LIKE :term";
+    if (filter.lowStockOnly)
+        sql += " AND i.quantity < COALESCE(i.min_stock, c.low_stock_threshold, :default_threshold)";
+    if (!countOnly)
+        sql += " ORDER BY i.name";
+    return sql;
+}
+
+void DatabaseManager::bindComponentFilter(QSqlQuery &query, const ComponentFilter &filter, int defaultThreshold)
+{
+    if (!filter.category.isEmpty())
+        query.bindValue(":type", filter.category);
+    if (!filter.nameContains.isEmpty())
+        query.bindValue(":term", "%" + filter.nameContains + "%");
+    if (filter.lowStockOnly)
+        query.bindValue(":default_threshold", defaultThreshold);
+}
+
+bool DatabaseManager::forEachComponent(const ComponentFilter &filter, const std::function<bool(const Component &)> &visit)
+{
+    TRACE_SCOPE("db", "DatabaseManager::forEachComponent");
+    TimedQuery query(m_database, m_queryStats);
+    query.setForwardOnly(true);
+    query.prepare(filteredComponentSql(filter));
+    bindComponentFilter(query, filter, AppConfig::instance().settings()->lowStockThreshold);
+
+    if (!query.exec())
+    {
+        m_lastError = query.lastError();
+        emit errorOccurred(QString("Failed to read components: %1").arg(m_lastError.text()));
+        return false;
+    }
+
+    while (query.next())
+    {
+        std::unique_ptr<Component> component = hydrateComponent(query, m_categoryRegistry);
+        if (component && !visit(*component))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+int DatabaseManager::adjustQuantities(const std::vector<std::pair<int, int>> &deltas)
+{
+    TRACE_SCOPE("db", "DatabaseManager::adjustQuantities");
+    if (deltas.empty())
+        return 0;
+
+    if (!beginTransaction())
+        return -1;
+
+    int changed = 0;
+    {
+        TimedQuery query(m_database, m_queryStats);
+        query.prepare("UPDATE inventory SET quantity = MAX(0, quantity + :delta) WHERE id = :id");
+        for (const auto &delta : deltas)
+        {
+            query.bindValue(":delta", delta.second);
+            query.bindValue(":id", delta.first);
+            if (!query.exec())
+            {
+                m_lastError = query.lastError();
+                query.finish();
+                rollbackTransaction();
+                emit errorOccurred(QString("Failed to adjust quantities: %1").arg(m_lastError.text()));
+                return -1;
+            }
+            changed += query.numRowsAffected();
+        }
+    }
+
+    if (!commitTransaction())
+        return -1;
+
+    if (changed > 0)
+    {
+        notifyDataChanged();
+    }
+    return changed;
+}
+
 bool DatabaseManager::populateSampleData()
 {
+    TRACE_SCOPE("db", "DatabaseManager::populateSampleData");
     // Check if data already exists
-    QSqlQuery countQuery(m_database);
+    TimedQuery countQuery(m_database, m_queryStats);
     if (countQuery.exec("SELECT COUNT(*) FROM inventory") && countQuery.next())
     {
         if (countQuery.value(0).toInt() > 0)
@@ -730,12 +1142,9 @@ bool DatabaseManager::populateSampleData()
         -1, "LED-RED-5mm", "Kingbright", 9, "Diode", 2.0, 2, ""));
 
     // Add all samples to database
-    for (const auto &component : samples)
+    if (addComponents(samples) < 0)
     {
-        if (addComponent(component.get()) < 0)
-        {
-            return false;
-        }
+        return false;
     }
 
     qDebug() << "Sample data populated successfully";
@@ -4,12 +4,41 @@
 #include <QObject>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "models/Component.h"
 #include "models/PassiveComponent.h"
 #include "models/ActiveComponent.h"
 #include "models/CategoryInfo.h"
+#include "models/CategoryRegistry.h"
+#include "database/QueryStats.h"
+
+/**
+ * @brief Row filter for streaming reads; empty fields match everything
+ */
+struct ComponentFilter
+{
+    QString category;
+    QString nameContains;
+    bool lowStockOnly = false;
+};
+
+/**
+ * @brief Column values of one inventory row, before they become a Component
+ */
+struct ComponentRow
+{
+    int id = 0;
+    QString name;
+    QString manufacturer;
+    QString type;
+    int quantity = 0;
+    double param1 = 0.0;
+    QString param2;
+    QString extraData;
+    int minStock = -1;
+};
 
 class DatabaseManager : public QObject
 {
@@ -23,9 +52,26 @@ public:
     DatabaseManager &operator=(const DatabaseManager &) = delete;
 
     bool initialize(const QString &dbPath = "inventory.db");
+    /// Close the connection so initialize() can open a different database
+    void close();
     bool isConnected() const;
     QSqlError lastError() const;
 
+    /**
+     * @brief Group writes into one transaction
+     *
+     * Calls nest: only the outermost commit is written, so batch tools can
+     * wrap several addComponents() calls in a single transaction. A
+     * rollback at any depth discards the whole transaction.
+     */
+    bool beginTransaction();
+    bool commitTransaction();
+    void rollbackTransaction();
+
+    /// Rebuild the database file to reclaim free pages; not allowed inside a transaction
+    bool vacuum();
+    QString databasePath() const { return m_database.databaseName(); }
+
     // ==================== Category Operations ====================
     std::vector<CategoryInfo> fetchAllCategories();
     CategoryInfo fetchCategory(int id);
@@ -42,8 +88,20 @@ public:
     int getComponentCountForCategory(const QString &categoryName);
     int getComponentCountForCategory(int categoryId);
 
+    /// Categories and their low stock thresholds, kept in sync with the categories table
+    const CategoryRegistry &categoryRegistry() const { return m_categoryRegistry; }
+
+    /// Latency of every statement run through this manager's connection
+    QueryStats &queryStats() { return m_queryStats; }
+
     // ==================== Component Operations ====================
     int addComponent(const Component *component);
+
+    /**
+     * @brief Insert many components in one transaction through a single prepared statement
+     * @return Number of rows inserted, or -1 if the batch was rolled back
+     */
+    int addComponents(const std::vector<std::unique_ptr<Component>> &components);
     bool updateComponent(const Component *component);
     bool deleteComponent(int id);
     std::unique_ptr<Component> fetchComponent(int id);
@@ -51,11 +109,67 @@ public:
 
     // Filter Operations
     std::vector<std::unique_ptr<Component>> fetchByCategory(const QString &categoryName);
-    std::vector<std::unique_ptr<Component>> fetchLowStock(int threshold = 10);
+
+    /**
+     * @brief Fetch components below their reorder point
+     *
+     * The reorder point is the component's min_stock, else its category's
+     * low_stock_threshold, else the global default from AppConfig.
+     */
+    std::vector<std::unique_ptr<Component>> fetchLowStock();
+    int countLowStock();
+
     std::vector<std::unique_ptr<Component>> searchByName(const QString &searchTerm);
 
+    int componentCount();
+
+    /**
+     * @brief Stream matching components, ordered by name, one at a time
+     *
+     * Reads with a forward-only query and hydrates one row per call, so
+     * memory stays constant however large the inventory is.
+     * @param visit Called for each component; return false to stop early
+     * @return false if the query failed
+     */
+    bool forEachComponent(const ComponentFilter &filter, const std::function<bool(const Component &)> &visit);
+
+    /// SELECT over inventory restricted by filter, ordered by name unless countOnly
+    static QString filteredComponentSql(const ComponentFilter &filter, bool countOnly = false);
+    static void bindComponentFilter(class QSqlQuery &query, const ComponentFilter &filter, int defaultThreshold);
+
+    /**
+     * @brief Add deltas to quantities, clamping at zero, through one prepared statement
+     * @param deltas Pairs of component id and quantity change
+     * @return Number of components changed, or -1 on error
+     */
+    int adjustQuantities(const std::vector<std::pair<int, int>> &deltas);
+
     bool populateSampleData();
 
+    /**
+     * @brief Build the component for the current row of an inventory query
+     *
+     * Only reads the registry, so background loaders can call it with
+     * their own copy and connection.
+     */
+    static std::unique_ptr<Component> hydrateComponent(const class QSqlQuery &query, const CategoryRegistry &registry);
+    /// Copy the column values of the current row of an inventory query
+    static void readComponentRow(const class QSqlQuery &query, ComponentRow &row);
+    /// Instantiate the Component subclass the row's category calls for
+    static std::unique_ptr<Component> buildComponent(const ComponentRow &row, const CategoryRegistry &registry);
+
+    /**
+     * @brief Read bulk loads through the native sqlite3 handle when possible
+     *
+     * Enabled by default; only takes effect in builds with
+     * ECIM_NATIVE_SQLITE (see NativeRowReader). Benchmarks turn it off to
+     * compare against the QtSql path.
+     */
+    void setNativeReadsEnabled(bool enabled) { m_nativeReadsEnabled = enabled; }
+    bool nativeReadsEnabled() const { return m_nativeReadsEnabled; }
+    /// Whether the open connection can be read natively at all
+    bool nativeReadsAvailable() const;
+
 signals:
     void dataChanged();
     void categoriesChanged();
@@ -70,12 +184,20 @@ private:
 
     bool createCategoriesTable();
     bool populateDefaultCategories();
+    bool ensureColumn(const QString &table, const QString &column, const QString &definition);
+    void reloadCategoryRegistry();
 
-    std::unique_ptr<Component> hydrateComponent(const class QSqlQuery &query);
+    /// Emit dataChanged now, or after the outermost commit when inside a transaction
+    void notifyDataChanged();
 
     QSqlDatabase m_database;
     QString m_connectionName;
     QSqlError m_lastError;
+    CategoryRegistry m_categoryRegistry;
+    QueryStats m_queryStats;
+    int m_transactionDepth;
+    bool m_dataChangedPending;
+    bool m_nativeReadsEnabled;
 };
 
 #endif // DATABASEMANAGER_H
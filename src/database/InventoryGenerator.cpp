@@ -0,0 +1,264 @@
+#include "database/InventoryGenerator.h"
+#include "database/DatabaseManager.h"
+#include "utils/SiValue.h"
+#include "utils/Trace.h"
+#include <cmath>
+
+namespace
+{
+    const double E6[] = {1.0, 1.5, 2.2, 3.3, 4.7, 6.8};
+    const double E12[] = {1.0, 1.2, 1.5, 1.8, 2.2, 2.7, 3.3, 3.9, 4.7, 5.6, 6.8, 8.2};
+    const double E24[] = {1.0, 1.1, 1.2, 1.3, 1.5, 1.6, 1.8, 2.0, 2.2, 2.4, 2.7, 3.0,
+                          3.3, 3.6, 3.9, 4.3, 4.7, 5.1, 5.6, 6.2, 6.8, 7.5, 8.2, 9.1};
+
+    /// Matches the category type in CategoryRegistry
+    enum class CategoryKind
+    {
+        Passive,
+        Active,
+        Other
+    };
+
+    struct Category
+    {
+        const char *name;
+        double weight;
+        CategoryKind kind;
+    };
+
+    // Roughly the mix of a hobby/lab stock: mostly resistors and capacitors
+    const Category CATEGORIES[] = {
+        {"Resistor", 40.0, CategoryKind::Passive},
+        {"Capacitor", 25.0, CategoryKind::Passive},
+        {"Inductor", 4.0, CategoryKind::Passive},
+        {"IC", 12.0, CategoryKind::Active},
+        {"Transistor", 6.0, CategoryKind::Active},
+        {"Diode", 7.0, CategoryKind::Active},
+        {"Connector", 4.0, CategoryKind::Other},
+        {"Other", 2.0, CategoryKind::Other}};
+    constexpr int CATEGORY_COUNT = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+
+    const char *const PACKAGES[] = {"0402", "0603", "0805", "1206", "THT"};
+    const double PACKAGE_WEIGHTS[] = {15.0, 35.0, 30.0, 12.0, 8.0};
+    constexpr int PACKAGE_COUNT = sizeof(PACKAGES) / sizeof(PACKAGES[0]);
+
+    // Listed by popularity; picked with Zipf weights 1/(rank+1)
+    const char *const PASSIVE_MANUFACTURERS[] = {"Yageo", "Murata", "Samsung", "Vishay", "TDK", "Panasonic", "KEMET", "Bourns", "Wurth", "AVX"};
+    const char *const ACTIVE_MANUFACTURERS[] = {"Texas Instruments", "STMicroelectronics", "ON Semiconductor", "Microchip", "NXP",
+                                                "Infineon", "Analog Devices", "Nexperia", "Diodes Inc", "Espressif"};
+    constexpr int MANUFACTURER_COUNT = 10;
+
+    constexpr double TWO_PI = 6.283185307179586;
+
+    const int PIN_COUNTS[] = {8, 14, 16, 20, 28, 32, 48, 64, 100};
+    const double VOLTAGES[] = {1.8, 3.3, 5.0, 12.0, 24.0};
+
+    /// Running sums of weights, normalized to end at 1
+    template <int N>
+    struct CumulativeWeights
+    {
+        double values[N];
+
+        explicit CumulativeWeights(const double (&weights)[N])
+        {
+            double total = 0.0;
+            for (int i = 0; i < N; ++i)
+                total += weights[i];
+            double sum = 0.0;
+            for (int i = 0; i < N; ++i)
+            {
+                sum += weights[i];
+                values[i] = sum / total;
+            }
+        }
+    };
+
+    const CumulativeWeights<CATEGORY_COUNT> &categoryWeights()
+    {
+        static const CumulativeWeights<CATEGORY_COUNT> weights = []()
+        {
+            double raw[CATEGORY_COUNT];
+            for (int i = 0; i < CATEGORY_COUNT; ++i)
+                raw[i] = CATEGORIES[i].weight;
+            return CumulativeWeights<CATEGORY_COUNT>(raw);
+        }();
+        return weights;
+    }
+
+    const CumulativeWeights<PACKAGE_COUNT> &packageWeights()
+    {
+        static const CumulativeWeights<PACKAGE_COUNT> weights(PACKAGE_WEIGHTS);
+        return weights;
+    }
+
+    const CumulativeWeights<MANUFACTURER_COUNT> &manufacturerWeights()
+    {
+        static const CumulativeWeights<MANUFACTURER_COUNT> weights = []()
+        {
+            double raw[MANUFACTURER_COUNT];
+            for (int i = 0; i < MANUFACTURER_COUNT; ++i)
+                raw[i] = 1.0 / (i + 1);
+            return CumulativeWeights<MANUFACTURER_COUNT>(raw);
+        }();
+        return weights;
+    }
+
+    QString unitFor(const QString &category)
+    {
+        if (category == "Resistor")
+            return QString::fromUtf8("Ω");
+        if (category == "Capacitor")
+            return "F";
+        return "H";
+    }
+}
+
+InventoryGenerator::InventoryGenerator()
+    : InventoryGenerator(Options())
+{
+}
+
+InventoryGenerator::InventoryGenerator(const Options &options)
+    : m_options(options), m_engine(options.seed), m_serial(0)
+{
+}
+
+double InventoryGenerator::uniform()
+{
+    // Top 53 bits give an exactly representable double in [0, 1)
+    return static_cast<double>(m_engine() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int InventoryGenerator::pick(const double *cumulativeWeights, int count)
+{
+    double u = uniform();
+    for (int i = 0; i < count - 1; ++i)
+    {
+        if (u < cumulativeWeights[i])
+            return i;
+    }
+    return count - 1;
+}
+
+double InventoryGenerator::eSeriesValue(const double *series, int seriesSize, int minDecade, int maxDecade)
+{
+    int decade = minDecade + static_cast<int>(uniform() * (maxDecade - minDecade + 1));
+    return series[static_cast<int>(uniform() * seriesSize)] * std::pow(10.0, decade);
+}
+
+int InventoryGenerator::quantity()
+{
+    int threshold = m_options.lowStockThreshold;
+    if (uniform() < m_options.lowStockRatio)
+    {
+        return static_cast<int>(uniform() * threshold);
+    }
+
+    // Log-normal around ~100 pieces with a long tail of reels; Box-Muller keeps it portable
+    double u1 = 1.0 - uniform();
+    double u2 = uniform();
+    double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(TWO_PI * u2);
+    int value = static_cast<int>(std::exp(std::log(100.0) + 1.2 * normal));
+    return qBound(threshold, value, 50000);
+}
+
+std::unique_ptr<Component> InventoryGenerator::makePassive(const QString &category)
+{
+    double value;
+    if (category == "Resistor")
+        value = eSeriesValue(E24, 24, 0, 6); // 1Ω .. 9.1MΩ
+    else if (category == "Capacitor")
+        value = eSeriesValue(E12, 12, -12, -4); // 1pF .. 820µF
+    else
+        value = eSeriesValue(E6, 6, -6, -2); // 1µH .. 68mH
+
+    const char *package = PACKAGES[pick(packageWeights().values, PACKAGE_COUNT)];
+    const char *manufacturer = PASSIVE_MANUFACTURERS[pick(manufacturerWeights().values, MANUFACTURER_COUNT)];
+    QString name = QString("%1-%2-%3").arg(category.left(3).toUpper(), SiValue::toString(value), QString::fromLatin1(package));
+
+    return std::make_unique<PassiveComponent>(-1, name, manufacturer, quantity(), category,
+                                              value, unitFor(category), package);
+}
+
+std::unique_ptr<Component> InventoryGenerator::makeActive(const QString &category)
+{
+    const char *manufacturer = ACTIVE_MANUFACTURERS[pick(manufacturerWeights().values, MANUFACTURER_COUNT)];
+    double voltage = VOLTAGES[static_cast<int>(uniform() * 5)];
+    int pins;
+    QString name;
+    if (category == "IC")
+    {
+        pins = PIN_COUNTS[static_cast<int>(uniform() * 9)];
+        name = QString("IC-%1-%2P").arg(m_serial % 5000, 4, 10, QChar('0')).arg(pins);
+    }
+    else if (category == "Transistor")
+    {
+        pins = 3;
+        name = QString("Q-%1").arg(2000 + m_serial % 8000);
+    }
+    else
+    {
+        pins = 2;
+        name = QString("1N%1").arg(4000 + m_serial % 2000);
+    }
+
+    return std::make_unique<ActiveComponent>(-1, name, manufacturer, quantity(), category, voltage, pins, QString());
+}
+
+std::unique_ptr<Component> InventoryGenerator::makeOther(const QString &category)
+{
+    // Stored the way DatabaseManager::buildComponent reads categories that are neither
+    // passive nor active: a passive with a plain count as its value and no unit
+    const char *manufacturer = PASSIVE_MANUFACTURERS[pick(manufacturerWeights().values, MANUFACTURER_COUNT)];
+    const bool connector = category == "Connector";
+    double positions = connector ? 2 + static_cast<int>(uniform() * 39) : 1;
+    const char *package = connector ? "THT" : PACKAGES[pick(packageWeights().values, PACKAGE_COUNT)];
+    QString name = QString("%1-%2").arg(connector ? "CONN" : "MISC").arg(m_serial % 10000, 4, 10, QChar('0'));
+
+    return std::make_unique<PassiveComponent>(-1, name, manufacturer, quantity(), category,
+                                              positions, QString(), package);
+}
+
+std::unique_ptr<Component> InventoryGenerator::next()
+{
+    const Category &category = CATEGORIES[pick(categoryWeights().values, CATEGORY_COUNT)];
+    ++m_serial;
+    QString name = QString::fromLatin1(category.name);
+    switch (category.kind)
+    {
+    case CategoryKind::Passive:
+        return makePassive(name);
+    case CategoryKind::Active:
+        return makeActive(name);
+    case CategoryKind::Other:
+        break;
+    }
+    return makeOther(name);
+}
+
+std::vector<std::unique_ptr<Component>> InventoryGenerator::generate(int count)
+{
+    std::vector<std::unique_ptr<Component>> components;
+    components.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        components.push_back(next());
+    }
+    return components;
+}
+
+qint64 InventoryGenerator::populate(DatabaseManager &database, qint64 count, int batchSize)
+{
+    TRACE_SCOPE("db", "InventoryGenerator::populate");
+    qint64 inserted = 0;
+    while (inserted < count)
+    {
+        int size = static_cast<int>(qMin<qint64>(batchSize, count - inserted));
+        if (database.addComponents(generate(size)) < 0)
+        {
+            return -1;
+        }
+        inserted += size;
+    }
+    return inserted;
+}
@@ -0,0 +1,67 @@
+#ifndef INVENTORYGENERATOR_H
+#define INVENTORYGENERATOR_H
+
+#include <QString>
+#include <QtGlobal>
+#include <memory>
+#include <random>
+#include <vector>
+#include "models/Component.h"
+
+class DatabaseManager;
+
+/**
+ * @brief Seeded synthetic inventory for load testing and benchmarks
+ *
+ * Produces components with a realistic category mix, E-series values,
+ * package spread, a skewed manufacturer popularity and a long-tailed
+ * quantity distribution, with a fixed share of rows below the low stock
+ * threshold. The same seed yields the same rows on the same platform and
+ * toolchain. Sampling is done on the raw mt19937_64 output rather than
+ * std:: distributions, whose algorithms differ between standard libraries,
+ * but values and quantities go through std::pow, std::log and std::exp,
+ * whose last bits may differ between math libraries.
+ */
+class InventoryGenerator
+{
+public:
+    struct Options
+    {
+        quint64 seed = 1;
+        double lowStockRatio = 0.08; ///< Share of rows with quantity below lowStockThreshold
+        int lowStockThreshold = 10;
+    };
+
+    static constexpr int DEFAULT_BATCH_SIZE = 10000;
+
+    InventoryGenerator();
+    explicit InventoryGenerator(const Options &options);
+
+    std::unique_ptr<Component> next();
+    std::vector<std::unique_ptr<Component>> generate(int count);
+
+    /**
+     * @brief Generate count components straight into the database
+     *
+     * Rows are built and inserted in batches through
+     * DatabaseManager::addComponents, so memory stays bounded.
+     * @return Number of rows inserted, or -1 on a database error
+     */
+    qint64 populate(DatabaseManager &database, qint64 count, int batchSize = DEFAULT_BATCH_SIZE);
+
+private:
+    double uniform();
+    int pick(const double *cumulativeWeights, int count);
+    double eSeriesValue(const double *series, int seriesSize, int minDecade, int maxDecade);
+    int quantity();
+
+    std::unique_ptr<Component> makePassive(const QString &category);
+    std::unique_ptr<Component> makeActive(const QString &category);
+    std::unique_ptr<Component> makeOther(const QString &category);
+
+    Options m_options;
+    std::mt19937_64 m_engine;
+    qint64 m_serial;
+};
+
+#endif // INVENTORYGENERATOR_H
@@ -0,0 +1,394 @@
+#include "database/InventorySnapshot.h"
+#include "models/ActiveComponent.h"
+#include "models/PassiveComponent.h"
+#include "utils/Trace.h"
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <cstring>
+#include <limits>
+
+struct InventorySnapshot::Header
+{
+    char magic[4];
+    quint32 version;
+    quint32 byteOrder; // Written as BYTE_ORDER_MARK, reads back differently on a foreign machine
+    quint32 recordSize;
+    quint32 recordCount;
+    quint32 stringCount;
+    quint64 stringIndexOffset;
+    quint64 charOffset;
+    quint64 charCount; // UTF-16 code units in the string data
+    qint64 databaseSize;
+    qint64 databaseModified;
+    qint64 walSize;
+    quint32 databasePath; // String index of the canonical database path
+    quint32 reserved;
+};
+
+struct InventorySnapshot::Record
+{
+    double param1;
+    qint32 id;
+    qint32 quantity;
+    qint32 minStock;
+    qint32 pinCount;
+    quint32 name; // Indices into the string table
+    quint32 manufacturer;
+    quint32 category;
+    quint32 text1; // Unit for passives, datasheet link for actives
+    quint32 text2; // Package for passives
+    quint8 kind;
+    quint8 reserved[3];
+};
+
+struct InventorySnapshot::StringRef
+{
+    quint32 offset; // In UTF-16 code units from the start of the string data
+    quint32 length;
+};
+
+namespace
+{
+    const char MAGIC[4] = {'E', 'C', 'S', 'N'};
+    constexpr quint32 BYTE_ORDER_MARK = 0x01020304;
+
+    enum RecordKind : quint8
+    {
+        KindPassive = 0,
+        KindActive = 1
+    };
+
+    /// Hands out one index per distinct string, in order of first use
+    class StringTableBuilder
+    {
+    public:
+        quint32 add(const QString &text)
+        {
+            auto it = m_indices.constFind(text);
+            if (it != m_indices.constEnd())
+            {
+                return it.value();
+            }
+            quint32 index = static_cast<quint32>(m_strings.size());
+            m_indices.insert(text, index);
+            m_strings.push_back(text);
+            return index;
+        }
+
+        const std::vector<QString> &strings() const { return m_strings; }
+
+    private:
+        QHash<QString, quint32> m_indices;
+        std::vector<QString> m_strings;
+    };
+
+    bool fail(QString *error, const QString &message)
+    {
+        if (error)
+        {
+            *error = message;
+        }
+        return false;
+    }
+}
+
+InventorySnapshot::InventorySnapshot()
+    : m_data(nullptr), m_size(0), m_recordCount(0), m_stringCount(0), m_records(nullptr), m_strings(nullptr),
+      m_chars(nullptr), m_charCount(0)
+{
+    // The file is read in place, so these layouts are part of the format
+    static_assert(sizeof(Header) == 80, "snapshot header layout changed");
+    static_assert(sizeof(Record) == 48, "snapshot record layout changed");
+    static_assert(sizeof(StringRef) == 8, "snapshot string index layout changed");
+    static_assert(sizeof(QChar) == sizeof(char16_t), "string data is stored as UTF-16");
+}
+
+InventorySnapshot::~InventorySnapshot()
+{
+    close();
+}
+
+InventorySnapshot::Stamp InventorySnapshot::stampFor(const QString &databasePath)
+{
+    Stamp stamp;
+    QFileInfo database(databasePath);
+    if (!database.exists())
+    {
+        return stamp;
+    }
+    stamp.databasePath = database.canonicalFilePath();
+    stamp.databaseSize = database.size();
+    stamp.databaseModified = database.lastModified().toMSecsSinceEpoch();
+
+    QFileInfo wal(databasePath + "-wal");
+    stamp.walSize = wal.exists() ? wal.size() : 0;
+    return stamp;
+}
+
+bool InventorySnapshot::write(const QString &path, const Stamp &stamp,
+                              const std::vector<const Component *> &components, QString *error)
+{
+    TRACE_SCOPE("db", "InventorySnapshot::write");
+    StringTableBuilder strings;
+    std::vector<Record> records;
+    records.reserve(components.size());
+
+    for (const Component *component : components)
+    {
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        record.param1 = component->getParam1();
+        record.id = component->getId();
+        record.quantity = component->getQuantity();
+        record.minStock = component->getMinStock();
+        record.name = strings.add(component->getName());
+        record.manufacturer = strings.add(component->getManufacturer());
+        record.category = strings.add(component->getCategory());
+
+        if (auto *active = dynamic_cast<const ActiveComponent *>(component))
+        {
+            record.kind = KindActive;
+            record.pinCount = active->getPinCount();
+            record.text1 = strings.add(active->getDatasheetLink());
+            record.text2 = strings.add(QString());
+        }
+        else
+        {
+            auto *passive = dynamic_cast<const PassiveComponent *>(component);
+            record.kind = KindPassive;
+            record.text1 = strings.add(passive ? passive->getUnit() : QString());
+            record.text2 = strings.add(component->getParam2());
+        }
+        records.push_back(record);
+    }
+
+    const quint32 databasePath = strings.add(stamp.databasePath);
+
+    std::vector<StringRef> index;
+    index.reserve(strings.strings().size());
+    quint64 charCount = 0;
+    for (const QString &text : strings.strings())
+    {
+        if (charCount + static_cast<quint64>(text.size()) > std::numeric_limits<quint32>::max())
+        {
+            return fail(error, QString("Snapshot string table too large"));
+        }
+        index.push_back({static_cast<quint32>(charCount), static_cast<quint32>(text.size())});
+        charCount += static_cast<quint64>(text.size());
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.recordSize = sizeof(Record);
+    header.recordCount = static_cast<quint32>(records.size());
+    header.stringCount = static_cast<quint32>(index.size());
+    header.stringIndexOffset = sizeof(Header) + records.size() * sizeof(Record);
+    header.charOffset = header.stringIndexOffset + index.size() * sizeof(StringRef);
+    header.charCount = charCount;
+    header.databaseSize = stamp.databaseSize;
+    header.databaseModified = stamp.databaseModified;
+    header.walSize = stamp.walSize;
+    header.databasePath = databasePath;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return fail(error, QString("Cannot write %1: %2").arg(path, file.errorString()));
+    }
+
+    bool ok = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == sizeof(header);
+    if (ok && !records.empty())
+    {
+        const qint64 bytes = static_cast<qint64>(records.size() * sizeof(Record));
+        ok = file.write(reinterpret_cast<const char *>(records.data()), bytes) == bytes;
+    }
+    if (ok && !index.empty())
+    {
+        const qint64 bytes = static_cast<qint64>(index.size() * sizeof(StringRef));
+        ok = file.write(reinterpret_cast<const char *>(index.data()), bytes) == bytes;
+    }
+    for (const QString &text : strings.strings())
+    {
+        if (!ok)
+        {
+            break;
+        }
+        const qint64 bytes = static_cast<qint64>(text.size()) * static_cast<qint64>(sizeof(QChar));
+        ok = file.write(reinterpret_cast<const char *>(text.constData()), bytes) == bytes;
+    }
+
+    if (!ok || !file.commit())
+    {
+        file.cancelWriting();
+        return fail(error, QString("Cannot write %1: %2").arg(path, file.errorString()));
+    }
+    return true;
+}
+
+bool InventorySnapshot::open(const QString &path, const QString &databasePath, QString *error)
+{
+    TRACE_SCOPE("db", "InventorySnapshot::open");
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return fail(error, QString("Cannot open %1: %2").arg(path, m_file.errorString()));
+    }
+
+    const qint64 size = m_file.size();
+    if (size < static_cast<qint64>(sizeof(Header)))
+    {
+        m_file.close();
+        return fail(error, QString("%1 is not an inventory snapshot").arg(path));
+    }
+
+    const uchar *data = m_file.map(0, size);
+    if (!data)
+    {
+        m_file.close();
+        return fail(error, QString("Cannot map %1: %2").arg(path, m_file.errorString()));
+    }
+
+    // Mappings are page aligned and every section starts on a multiple of its alignment
+    const auto *header = reinterpret_cast<const Header *>(data);
+    const quint64 fileSize = static_cast<quint64>(size);
+    QString problem;
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+        problem = "not an inventory snapshot";
+    else if (header->byteOrder != BYTE_ORDER_MARK)
+        problem = "written on a machine with a different byte order";
+    else if (header->version != FORMAT_VERSION || header->recordSize != sizeof(Record))
+        problem = QString("unsupported format version %1").arg(header->version);
+    else if (header->stringIndexOffset != sizeof(Header) + quint64(header->recordCount) * sizeof(Record) ||
+             header->charOffset != header->stringIndexOffset + quint64(header->stringCount) * sizeof(StringRef) ||
+             header->charOffset > fileSize || header->charCount > (fileSize - header->charOffset) / sizeof(char16_t))
+        problem = "truncated or damaged";
+
+    const StringRef *strings = nullptr;
+    if (problem.isEmpty())
+    {
+        strings = reinterpret_cast<const StringRef *>(data + header->stringIndexOffset);
+        for (quint32 i = 0; i < header->stringCount; ++i)
+        {
+            if (quint64(strings[i].offset) + strings[i].length > header->charCount)
+            {
+                problem = "truncated or damaged";
+                break;
+            }
+        }
+        if (problem.isEmpty() && header->databasePath >= header->stringCount)
+            problem = "truncated or damaged";
+    }
+
+    QString snapshotDatabase;
+    if (problem.isEmpty())
+    {
+        const StringRef &ref = strings[header->databasePath];
+        const auto *chars = reinterpret_cast<const QChar *>(data + header->charOffset);
+        snapshotDatabase = QString(chars + ref.offset, static_cast<qsizetype>(ref.length));
+        // Records of another inventory must not be shown even until a reload replaces them
+        if (snapshotDatabase != QFileInfo(databasePath).canonicalFilePath())
+            problem = QString("taken from another database (%1)").arg(snapshotDatabase);
+    }
+
+    if (!problem.isEmpty())
+    {
+        m_file.unmap(const_cast<uchar *>(data));
+        m_file.close();
+        return fail(error, QString("%1: %2").arg(path, problem));
+    }
+
+    m_data = data;
+    m_size = size;
+    m_stamp.databasePath = snapshotDatabase;
+    m_stamp.databaseSize = header->databaseSize;
+    m_stamp.databaseModified = header->databaseModified;
+    m_stamp.walSize = header->walSize;
+    m_recordCount = header->recordCount;
+    m_stringCount = header->stringCount;
+    m_records = reinterpret_cast<const Record *>(data + sizeof(Header));
+    m_strings = reinterpret_cast<const StringRef *>(data + header->stringIndexOffset);
+    m_chars = reinterpret_cast<const char16_t *>(data + header->charOffset);
+    m_charCount = header->charCount;
+    return true;
+}
+
+void InventorySnapshot::close()
+{
+    if (m_data)
+    {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+    if (m_file.isOpen())
+    {
+        m_file.close();
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_stamp = Stamp();
+    m_recordCount = 0;
+    m_stringCount = 0;
+    m_records = nullptr;
+    m_strings = nullptr;
+    m_chars = nullptr;
+    m_charCount = 0;
+}
+
+QString InventorySnapshot::stringAt(quint32 index, std::vector<QString> &cache) const
+{
+    if (index >= m_stringCount)
+    {
+        return QString();
+    }
+
+    // Copies out of the mapping, so components outlive the snapshot
+    QString &cached = cache[index];
+    if (cached.isNull() && m_strings[index].length > 0)
+    {
+        cached = QString(reinterpret_cast<const QChar *>(m_chars + m_strings[index].offset),
+                         static_cast<qsizetype>(m_strings[index].length));
+    }
+    return cached;
+}
+
+std::vector<std::unique_ptr<Component>> InventorySnapshot::loadAll() const
+{
+    TRACE_SCOPE("db", "InventorySnapshot::loadAll");
+    std::vector<std::unique_ptr<Component>> components;
+    if (!m_data)
+    {
+        return components;
+    }
+
+    std::vector<QString> cache(m_stringCount);
+    components.reserve(m_recordCount);
+    for (quint32 i = 0; i < m_recordCount; ++i)
+    {
+        const Record &record = m_records[i];
+        const QString name = stringAt(record.name, cache);
+        const QString manufacturer = stringAt(record.manufacturer, cache);
+        const QString category = stringAt(record.category, cache);
+
+        std::unique_ptr<Component> component;
+        if (record.kind == KindActive)
+        {
+            component = std::make_unique<ActiveComponent>(record.id, name, manufacturer, record.quantity, category,
+                                                          record.param1, record.pinCount,
+                                                          stringAt(record.text1, cache));
+        }
+        else
+        {
+            component = std::make_unique<PassiveComponent>(record.id, name, manufacturer, record.quantity, category,
+                                                           record.param1, stringAt(record.text1, cache),
+                                                           stringAt(record.text2, cache));
+        }
+        component->setMinStock(record.minStock);
+        components.push_back(std::move(component));
+    }
+    return components;
+}
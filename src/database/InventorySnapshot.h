@@ -0,0 +1,99 @@
+#ifndef INVENTORYSNAPSHOT_H
+#define INVENTORYSNAPSHOT_H
+
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "models/Component.h"
+
+/**
+ * @brief Binary copy of the inventory table for instant cold starts
+ *
+ * The snapshot is written on clean shutdown and memory-mapped on the next
+ * start, so the table can be shown before the database has been queried.
+ * Components are stored as fixed-width records that refer to a
+ * deduplicated string table. The header carries a stamp of the database
+ * file the snapshot was taken from; if the file has changed since, the
+ * snapshot is still shown but the caller reconciles it with a real load.
+ * A snapshot of a different database file is rejected outright.
+ *
+ * Snapshots are a cache. A missing, foreign or damaged file is rejected by
+ * open() and the caller falls back to loading from the database.
+ */
+class InventorySnapshot
+{
+public:
+    /**
+     * @brief Identifies the state of a database file
+     *
+     * SQLite's data_version only compares within one connection, so the
+     * stamp uses the file size and modification time instead. A non-empty
+     * WAL means the file holds changes that were never checkpointed.
+     */
+    struct Stamp
+    {
+        QString databasePath; // Canonical, so different spellings of one file compare equal
+        qint64 databaseSize = -1;
+        qint64 databaseModified = -1; // Milliseconds since the epoch
+        qint64 walSize = 0;
+
+        bool isValid() const { return databaseSize >= 0; }
+        bool operator==(const Stamp &other) const
+        {
+            return databasePath == other.databasePath && databaseSize == other.databaseSize &&
+                   databaseModified == other.databaseModified && walSize == other.walSize;
+        }
+        bool operator!=(const Stamp &other) const { return !(*this == other); }
+    };
+
+    InventorySnapshot();
+    ~InventorySnapshot();
+
+    InventorySnapshot(const InventorySnapshot &) = delete;
+    InventorySnapshot &operator=(const InventorySnapshot &) = delete;
+
+    /// Stamp of the database file as it is on disk now; invalid if it does not exist
+    static Stamp stampFor(const QString &databasePath);
+
+    /// Replaces the snapshot at @p path atomically
+    static bool write(const QString &path, const Stamp &stamp, const std::vector<const Component *> &components,
+                      QString *error = nullptr);
+
+    /**
+     * @brief Maps and validates the snapshot; on failure the object stays closed
+     * @param databasePath Database the caller is showing; a snapshot taken from another file is rejected
+     */
+    bool open(const QString &path, const QString &databasePath, QString *error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    Stamp stamp() const { return m_stamp; }
+    int componentCount() const { return static_cast<int>(m_recordCount); }
+
+    /// Builds every component in file order; strings are shared between components that repeat them
+    std::vector<std::unique_ptr<Component>> loadAll() const;
+
+    static constexpr quint32 FORMAT_VERSION = 2;
+
+private:
+    struct Header;
+    struct Record;
+    struct StringRef;
+
+    QString stringAt(quint32 index, std::vector<QString> &cache) const;
+
+    QFile m_file;
+    const uchar *m_data;
+    qint64 m_size;
+    Stamp m_stamp;
+    quint32 m_recordCount;
+    quint32 m_stringCount;
+    const Record *m_records;
+    const StringRef *m_strings;
+    const char16_t *m_chars;
+    quint64 m_charCount;
+};
+
+#endif // INVENTORYSNAPSHOT_H
@@ -0,0 +1,284 @@
+#include "database/NativeRowReader.h"
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QVariant>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#ifdef ECIM_NATIVE_SQLITE
+#include <sqlite3.h>
+#ifdef Q_OS_UNIX
+#include <dlfcn.h>
+#endif
+
+namespace
+{
+    /**
+     * Qt's driver may carry its own copy of SQLite. A handle must only be
+     * passed to the library that created it, and a matching version string
+     * does not prove that, so the native path is used only when the driver's
+     * module resolves sqlite3_libversion to the very function this build
+     * calls. Where that can't be checked, reads stay on QtSql.
+     */
+    bool driverUsesLinkedLibrary(const QSqlDatabase &database)
+    {
+#ifdef Q_OS_UNIX
+        static const bool sameLibrary = [&database]()
+        {
+            // The vtable pointer locates the module the driver was loaded from
+            const void *driverVtable = *reinterpret_cast<void *const *>(database.driver());
+            Dl_info info;
+            if (!dladdr(driverVtable, &info) || !info.dli_fname)
+            {
+                return false;
+            }
+
+            void *module = dlopen(info.dli_fname, RTLD_LAZY | RTLD_NOLOAD);
+            if (!module)
+            {
+                return false;
+            }
+            // Searches the module and its dependencies, as the driver's own calls are bound
+            void *driverSymbol = dlsym(module, "sqlite3_libversion");
+            dlclose(module);
+            return driverSymbol == reinterpret_cast<void *>(&sqlite3_libversion);
+        }();
+        return sameLibrary;
+#else
+        Q_UNUSED(database);
+        return false;
+#endif
+    }
+
+    const char *const COLUMN_NAMES[] = {"id", "name", "manufacturer", "type", "quantity",
+                                        "param_1", "param_2", "extra_data", "min_stock"};
+}
+#endif
+
+NativeRowReader::NativeRowReader(const QSqlDatabase &database)
+    : m_db(nullptr), m_statement(nullptr)
+{
+    std::fill(std::begin(m_columns), std::end(m_columns), -1);
+#ifdef ECIM_NATIVE_SQLITE
+    if (!database.isOpen() || database.driverName() != "QSQLITE" || !driverUsesLinkedLibrary(database))
+    {
+        return;
+    }
+
+    QVariant handle = database.driver()->handle();
+    if (handle.isValid() && qstrcmp(handle.typeName(), "sqlite3*") == 0)
+    {
+        m_db = *static_cast<sqlite3 *const *>(handle.constData());
+    }
+#else
+    Q_UNUSED(database);
+#endif
+}
+
+NativeRowReader::~NativeRowReader()
+{
+    finalize();
+}
+
+bool NativeRowReader::isCompiledIn()
+{
+#ifdef ECIM_NATIVE_SQLITE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NativeRowReader::finalize()
+{
+#ifdef ECIM_NATIVE_SQLITE
+    sqlite3_finalize(m_statement);
+#endif
+    m_statement = nullptr;
+}
+
+void NativeRowReader::setError()
+{
+#ifdef ECIM_NATIVE_SQLITE
+    m_error = QString::fromUtf8(sqlite3_errmsg(m_db));
+#endif
+}
+
+bool NativeRowReader::prepare(const QString &sql)
+{
+    finalize();
+    m_error.clear();
+    std::fill(std::begin(m_columns), std::end(m_columns), -1);
+    if (!m_db)
+    {
+        m_error = "Native SQLite reads are not available";
+        return false;
+    }
+
+#ifdef ECIM_NATIVE_SQLITE
+    const QByteArray utf8 = sql.toUtf8();
+    if (sqlite3_prepare_v2(m_db, utf8.constData(), static_cast<int>(utf8.size()), &m_statement, nullptr) != SQLITE_OK)
+    {
+        setError();
+        finalize();
+        return false;
+    }
+
+    const int count = sqlite3_column_count(m_statement);
+    for (int i = 0; i < count; ++i)
+    {
+        const char *name = sqlite3_column_name(m_statement, i);
+        for (int column = 0; column < ColumnCount; ++column)
+        {
+            if (m_columns[column] < 0 && qstricmp(name, COLUMN_NAMES[column]) == 0)
+            {
+                m_columns[column] = i;
+                break;
+            }
+        }
+    }
+
+    if (m_columns[ColId] < 0 || m_columns[ColName] < 0 || m_columns[ColType] < 0)
+    {
+        m_error = "Query does not select the inventory columns";
+        finalize();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(sql);
+    return false;
+#endif
+}
+
+bool NativeRowReader::bindText(int position, const QString &value)
+{
+#ifdef ECIM_NATIVE_SQLITE
+    const QByteArray utf8 = value.toUtf8();
+    if (!m_statement ||
+        sqlite3_bind_text(m_statement, position, utf8.constData(), static_cast<int>(utf8.size()), SQLITE_TRANSIENT) != SQLITE_OK)
+    {
+        setError();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(position);
+    Q_UNUSED(value);
+    return false;
+#endif
+}
+
+bool NativeRowReader::bindInt(int position, int value)
+{
+#ifdef ECIM_NATIVE_SQLITE
+    if (!m_statement || sqlite3_bind_int(m_statement, position, value) != SQLITE_OK)
+    {
+        setError();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(position);
+    Q_UNUSED(value);
+    return false;
+#endif
+}
+
+bool NativeRowReader::next(ComponentRow &row)
+{
+#ifdef ECIM_NATIVE_SQLITE
+    if (!m_statement)
+    {
+        return false;
+    }
+
+    const int rc = sqlite3_step(m_statement);
+    if (rc != SQLITE_ROW)
+    {
+        if (rc != SQLITE_DONE)
+        {
+            setError();
+        }
+        finalize();
+        return false;
+    }
+
+    // Columns the query does not select keep the defaults hydrateComponent would give them
+    auto intAt = [this](int column, int fallback)
+    {
+        const int index = m_columns[column];
+        return index < 0 || sqlite3_column_type(m_statement, index) == SQLITE_NULL
+                   ? fallback
+                   : sqlite3_column_int(m_statement, index);
+    };
+
+    row.id = intAt(ColId, 0);
+    row.name = text(ColName);
+    row.manufacturer = internedText(ColManufacturer, m_manufacturers);
+    row.type = internedText(ColType, m_types);
+    row.quantity = intAt(ColQuantity, 0);
+    row.param1 = m_columns[ColParam1] < 0 ? 0.0 : sqlite3_column_double(m_statement, m_columns[ColParam1]);
+    row.param2 = text(ColParam2);
+    row.extraData = text(ColExtraData);
+    row.minStock = intAt(ColMinStock, -1);
+    return true;
+#else
+    Q_UNUSED(row);
+    return false;
+#endif
+}
+
+QString NativeRowReader::text(int column) const
+{
+#ifdef ECIM_NATIVE_SQLITE
+    const int index = m_columns[column];
+    if (index < 0)
+    {
+        return QString();
+    }
+    // The UTF-8 form is what SQLite stores, so reading it needs no conversion on SQLite's side
+    const char *data = reinterpret_cast<const char *>(sqlite3_column_text(m_statement, index));
+    return data ? QString::fromUtf8(data, sqlite3_column_bytes(m_statement, index)) : QString();
+#else
+    Q_UNUSED(column);
+    return QString();
+#endif
+}
+
+QString NativeRowReader::internedText(int column, InternTable &table) const
+{
+#ifdef ECIM_NATIVE_SQLITE
+    const int index = m_columns[column];
+    if (index < 0)
+    {
+        return QString();
+    }
+    const char *data = reinterpret_cast<const char *>(sqlite3_column_text(m_statement, index));
+    if (!data)
+    {
+        return QString();
+    }
+
+    const int size = sqlite3_column_bytes(m_statement, index);
+    for (const auto &entry : table)
+    {
+        if (entry.first.size() == size && std::memcmp(entry.first.constData(), data, static_cast<size_t>(size)) == 0)
+        {
+            return entry.second;
+        }
+    }
+
+    QString decoded = QString::fromUtf8(data, size);
+    if (static_cast<int>(table.size()) < MAX_INTERNED)
+    {
+        table.emplace_back(QByteArray(data, size), decoded);
+    }
+    return decoded;
+#else
+    Q_UNUSED(column);
+    Q_UNUSED(table);
+    return QString();
+#endif
+}
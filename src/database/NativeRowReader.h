@@ -0,0 +1,84 @@
+#ifndef NATIVEROWREADER_H
+#define NATIVEROWREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include <utility>
+#include <vector>
+#include "database/DatabaseManager.h"
+
+class QSqlDatabase;
+struct sqlite3;
+struct sqlite3_stmt;
+
+/**
+ * @brief Reads inventory rows straight from the sqlite3 C API
+ *
+ * Bulk loads spend much of their time in QSqlQuery::value(), which boxes
+ * every cell into a QVariant before it is converted again. This reader
+ * steps a statement on the connection's native handle and decodes the
+ * columns directly into a ComponentRow. Category and manufacturer names
+ * repeat across rows, so the most common ones are decoded once and shared.
+ *
+ * Only available when built with ECIM_NATIVE_SQLITE, and only if Qt's
+ * SQLite driver uses the same SQLite library as this build. Otherwise
+ * isValid() is false and callers use QSqlQuery instead.
+ */
+class NativeRowReader
+{
+public:
+    /// The database must stay open while the reader is in use
+    explicit NativeRowReader(const QSqlDatabase &database);
+    ~NativeRowReader();
+
+    NativeRowReader(const NativeRowReader &) = delete;
+    NativeRowReader &operator=(const NativeRowReader &) = delete;
+
+    /// Whether this build links SQLite itself
+    static bool isCompiledIn();
+    bool isValid() const { return m_db != nullptr; }
+
+    /// Prepare a SELECT over the inventory table; columns are matched by name
+    bool prepare(const QString &sql);
+    /// Bind a text parameter, positions start at 1
+    bool bindText(int position, const QString &value);
+    bool bindInt(int position, int value);
+
+    /// Step to the next row and decode it; false at the end or on error
+    bool next(ComponentRow &row);
+    bool hasError() const { return !m_error.isEmpty(); }
+    QString lastError() const { return m_error; }
+
+private:
+    enum Column
+    {
+        ColId,
+        ColName,
+        ColManufacturer,
+        ColType,
+        ColQuantity,
+        ColParam1,
+        ColParam2,
+        ColExtraData,
+        ColMinStock,
+        ColumnCount
+    };
+
+    /// Few-valued columns keep their decoded strings so rows share them
+    using InternTable = std::vector<std::pair<QByteArray, QString>>;
+    static constexpr int MAX_INTERNED = 32;
+
+    QString text(int column) const;
+    QString internedText(int column, InternTable &table) const;
+    void finalize();
+    void setError();
+
+    sqlite3 *m_db;
+    sqlite3_stmt *m_statement;
+    int m_columns[ColumnCount];
+    InternTable m_types;
+    InternTable m_manufacturers;
+    QString m_error;
+};
+
+#endif // NATIVEROWREADER_H
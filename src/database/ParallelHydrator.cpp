@@ -0,0 +1,108 @@
+#include "database/ParallelHydrator.h"
+#include "utils/Trace.h"
+#include <QThreadPool>
+#include <algorithm>
+#include <chrono>
+
+ParallelHydrator::ParallelHydrator(const CategoryRegistry &registry, Deliver deliver, int blockRows,
+                                   int firstBlockRows)
+    : m_registry(registry), m_deliver(std::move(deliver)), m_blockRows(std::max(1, blockRows)),
+      m_nextBlockRows(firstBlockRows > 0 ? firstBlockRows : m_blockRows), m_buildNextInline(firstBlockRows > 0)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    m_maxInFlight = std::max(2, pool->maxThreadCount() * 2);
+    // With a single thread the hand-off only adds latency
+    m_usePool = pool->maxThreadCount() > 1;
+    m_rows.reserve(m_nextBlockRows);
+}
+
+ParallelHydrator::~ParallelHydrator()
+{
+    // Running tasks read m_registry, so they must finish before it goes away
+    for (auto &future : m_inFlight)
+    {
+        future.wait();
+    }
+}
+
+void ParallelHydrator::addRow(ComponentRow &&row)
+{
+    m_rows.push_back(std::move(row));
+    if (static_cast<int>(m_rows.size()) >= m_nextBlockRows)
+    {
+        submit();
+    }
+}
+
+void ParallelHydrator::finish()
+{
+    if (!m_rows.empty())
+    {
+        submit();
+    }
+    while (!m_inFlight.empty())
+    {
+        deliverReady(true);
+    }
+}
+
+ParallelHydrator::Block ParallelHydrator::buildBlock(const std::vector<ComponentRow> &rows,
+                                                     const CategoryRegistry &registry)
+{
+    TRACE_SCOPE("db", "ParallelHydrator::buildBlock");
+    Block block;
+    block.reserve(rows.size());
+    for (const ComponentRow &row : rows)
+    {
+        std::unique_ptr<Component> component = DatabaseManager::buildComponent(row, registry);
+        // Fill the display caches here rather than when the model builds its rows on the UI thread
+        component->getParam1Display();
+        component->getParam2Display();
+        component->getDetails();
+        block.push_back(std::move(component));
+    }
+    return block;
+}
+
+void ParallelHydrator::submit()
+{
+    std::vector<ComponentRow> rows;
+    rows.swap(m_rows);
+    m_nextBlockRows = m_blockRows;
+    m_rows.reserve(m_blockRows);
+
+    // Nothing is in flight ahead of the first block, so building it here keeps the order
+    const bool buildHere = !m_usePool || m_buildNextInline;
+    m_buildNextInline = false;
+    if (buildHere)
+    {
+        m_deliver(buildBlock(rows, m_registry));
+        return;
+    }
+
+    auto task = std::make_shared<std::packaged_task<Block()>>(
+        [this, rows = std::move(rows)]()
+        { return buildBlock(rows, m_registry); });
+    m_inFlight.push_back(task->get_future());
+    QThreadPool::globalInstance()->start([task]()
+                                         { (*task)(); });
+
+    deliverReady(static_cast<int>(m_inFlight.size()) >= m_maxInFlight);
+}
+
+void ParallelHydrator::deliverReady(bool wait)
+{
+    while (!m_inFlight.empty())
+    {
+        std::future<Block> &front = m_inFlight.front();
+        if (!wait && front.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
+        wait = false;
+
+        Block block = front.get();
+        m_inFlight.pop_front();
+        m_deliver(std::move(block));
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef PARALLELHYDRATOR_H
+#define PARALLELHYDRATOR_H
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "database/DatabaseManager.h"
+#include "models/CategoryRegistry.h"
+
+/**
+ * @brief Turns a stream of raw rows into components on the global QThreadPool
+ *
+ * Bulk loads are split in two stages. The thread that owns the query reads
+ * column values into blocks of ComponentRow, which is all that has to happen
+ * on the connection's thread. Each full block goes to a pool worker that
+ * instantiates the components and formats the display strings the table
+ * asks for first. Finished blocks are delivered on the reading thread in
+ * the order their rows were read, so the result does not depend on
+ * scheduling.
+ *
+ * At most a few blocks per core are in flight; addRow() waits for the
+ * oldest one when the pipeline is full, which keeps memory bounded.
+ * Destroying the hydrator before finish() waits for running blocks and
+ * drops their results.
+ */
+class ParallelHydrator
+{
+public:
+    using Block = std::vector<std::unique_ptr<Component>>;
+    using Deliver = std::function<void(Block &&block)>;
+
+    /**
+     * @param registry Copied, workers read the copy
+     * @param deliver Called on the reading thread with each block, in order
+     * @param blockRows Rows per block
+     * @param firstBlockRows Size of the first block, e.g. one screen; 0 uses blockRows.
+     *        A separately sized first block is built on the reading thread and
+     *        delivered at once, without waiting for a pool thread.
+     */
+    ParallelHydrator(const CategoryRegistry &registry, Deliver deliver, int blockRows = DEFAULT_BLOCK_ROWS,
+                     int firstBlockRows = 0);
+    ~ParallelHydrator();
+
+    ParallelHydrator(const ParallelHydrator &) = delete;
+    ParallelHydrator &operator=(const ParallelHydrator &) = delete;
+
+    void addRow(ComponentRow &&row);
+
+    /// Build the last partial block and deliver everything still in flight
+    void finish();
+
+    /// The work a pool task does for one block
+    static Block buildBlock(const std::vector<ComponentRow> &rows, const CategoryRegistry &registry);
+
+    static constexpr int DEFAULT_BLOCK_ROWS = 2048;
+
+private:
+    void submit();
+    /// Deliver finished blocks from the front; with wait, the oldest block is waited for first
+    void deliverReady(bool wait);
+
+    CategoryRegistry m_registry;
+    Deliver m_deliver;
+    int m_blockRows;
+    int m_nextBlockRows; // Size of the block being filled
+    bool m_buildNextInline;
+    int m_maxInFlight;
+    bool m_usePool;
+    std::vector<ComponentRow> m_rows;
+    std::deque<std::future<Block>> m_inFlight;
+};
+
+#endif // PARALLELHYDRATOR_H
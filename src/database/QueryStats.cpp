@@ -0,0 +1,207 @@
+#include "database/QueryStats.h"
+#include "utils/Trace.h"
+
+#include <QDebug>
+#include <QSqlError>
+#include <QStringList>
+#include <QVariant>
+#include <algorithm>
+
+QueryStats::QueryStats()
+    : m_slowThresholdNs(qint64(DEFAULT_SLOW_THRESHOLD_MS) * 1000000)
+{
+}
+
+bool QueryStats::record(const QString &sql, qint64 prepareNs, qint64 execNs, qint64 stepNs, qint64 rows)
+{
+    qint64 totalNs = prepareNs + execNs + stepNs;
+
+    QMutexLocker locker(&m_mutex);
+    StatementStats &stats = m_statements[sql];
+    if (stats.executions == 0)
+    {
+        stats.sql = sql;
+    }
+    ++stats.executions;
+    stats.rows += static_cast<quint64>(std::max<qint64>(rows, 0));
+    stats.prepare.record(prepareNs);
+    stats.exec.record(execNs);
+    stats.step.record(stepNs);
+    stats.total.record(totalNs);
+
+    return totalNs > m_slowThresholdNs;
+}
+
+void QueryStats::addSlowQuery(SlowQuery query)
+{
+    QMutexLocker locker(&m_mutex);
+    m_slowQueries.push_back(std::move(query));
+    if (m_slowQueries.size() > SLOW_LOG_CAPACITY)
+    {
+        m_slowQueries.pop_front();
+    }
+}
+
+void QueryStats::setSlowThresholdMs(int milliseconds)
+{
+    QMutexLocker locker(&m_mutex);
+    m_slowThresholdNs = qint64(std::max(0, milliseconds)) * 1000000;
+}
+
+int QueryStats::slowThresholdMs() const
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_slowThresholdNs / 1000000);
+}
+
+std::vector<QueryStats::StatementStats> QueryStats::statements() const
+{
+    std::vector<StatementStats> result;
+    {
+        QMutexLocker locker(&m_mutex);
+        result.reserve(m_statements.size());
+        for (const auto &stats : m_statements)
+        {
+            result.push_back(stats);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const StatementStats &a, const StatementStats &b)
+              { return a.total.mean() * static_cast<double>(a.total.count()) >
+                       b.total.mean() * static_cast<double>(b.total.count()); });
+    return result;
+}
+
+std::vector<QueryStats::SlowQuery> QueryStats::slowQueries() const
+{
+    QMutexLocker locker(&m_mutex);
+    return std::vector<SlowQuery>(m_slowQueries.begin(), m_slowQueries.end());
+}
+
+void QueryStats::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_statements.clear();
+    m_slowQueries.clear();
+}
+
+TimedQuery::TimedQuery(const QSqlDatabase &database, QueryStats &stats)
+    : QSqlQuery(database), m_database(database), m_stats(stats),
+      m_prepareNs(0), m_execNs(0), m_stepNs(0), m_rows(0), m_pending(false)
+{
+}
+
+TimedQuery::~TimedQuery()
+{
+    flush();
+}
+
+bool TimedQuery::prepare(const QString &query)
+{
+    flush();
+    m_sql = query;
+
+    qint64 start = Trace::nowNs();
+    bool ok = QSqlQuery::prepare(query);
+    m_prepareNs = Trace::nowNs() - start;
+    return ok;
+}
+
+bool TimedQuery::exec(const QString &query)
+{
+    flush();
+    m_sql = query;
+    m_prepareNs = 0;
+
+    // Unprepared statements are compiled inside exec, so that time counts as exec here
+    qint64 start = Trace::nowNs();
+    bool ok = QSqlQuery::exec(query);
+    m_execNs = Trace::nowNs() - start;
+    m_pending = true;
+    return ok;
+}
+
+bool TimedQuery::exec()
+{
+    flush();
+
+    qint64 start = Trace::nowNs();
+    bool ok = QSqlQuery::exec();
+    m_execNs = Trace::nowNs() - start;
+    m_pending = true;
+    return ok;
+}
+
+bool TimedQuery::next()
+{
+    qint64 start = Trace::nowNs();
+    bool ok = QSqlQuery::next();
+    m_stepNs += Trace::nowNs() - start;
+    if (ok)
+    {
+        ++m_rows;
+    }
+    return ok;
+}
+
+void TimedQuery::flush()
+{
+    if (!m_pending)
+    {
+        return;
+    }
+    m_pending = false;
+
+    qint64 rows = isSelect() ? m_rows : numRowsAffected();
+    record(m_stats, m_database, m_sql, m_prepareNs, m_execNs, m_stepNs, rows, boundValues());
+
+    // A prepared statement can be executed again; only the first run paid for preparing it
+    m_prepareNs = 0;
+    m_execNs = 0;
+    m_stepNs = 0;
+    m_rows = 0;
+}
+
+void TimedQuery::record(QueryStats &stats, const QSqlDatabase &database, const QString &sql, qint64 prepareNs,
+                        qint64 execNs, qint64 stepNs, qint64 rows, const QVariantList &boundValues)
+{
+    if (!stats.record(sql, prepareNs, execNs, stepNs, rows))
+    {
+        return;
+    }
+
+    QueryStats::SlowQuery slow{QDateTime::currentDateTime(), sql, prepareNs, execNs, stepNs, rows,
+                               explainPlan(database, sql, boundValues)};
+    qWarning().noquote() << QString("Slow query (%1 ms, %2 rows): %3\n%4")
+                                .arg((prepareNs + execNs + stepNs) / 1e6, 0, 'f', 1)
+                                .arg(rows)
+                                .arg(sql.simplified(), slow.plan);
+    stats.addSlowQuery(std::move(slow));
+}
+
+QString TimedQuery::explainPlan(const QSqlDatabase &database, const QString &sql, const QVariantList &boundValues)
+{
+    QSqlQuery explain(database);
+    if (!explain.prepare("EXPLAIN QUERY PLAN " + sql))
+    {
+        return explain.lastError().text();
+    }
+
+    for (int i = 0; i < boundValues.size(); ++i)
+    {
+        explain.bindValue(i, boundValues[i]);
+    }
+
+    if (!explain.exec())
+    {
+        return explain.lastError().text();
+    }
+
+    // Columns are id, parent, notused, detail
+    QStringList steps;
+    while (explain.next())
+    {
+        steps << explain.value(3).toString();
+    }
+    return steps.join('\n');
+}
@@ -0,0 +1,116 @@
+#ifndef QUERYSTATS_H
+#define QUERYSTATS_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QVariant>
+#include <deque>
+#include <vector>
+#include "utils/LatencyHistogram.h"
+
+/**
+ * @brief Latency histograms per SQL statement and a log of slow statements
+ *
+ * Thread-safe; worker connections record into the same instance as the
+ * main connection.
+ */
+class QueryStats
+{
+public:
+    struct StatementStats
+    {
+        QString sql;
+        quint64 executions = 0;
+        quint64 rows = 0;
+        LatencyHistogram prepare;
+        LatencyHistogram exec;
+        LatencyHistogram step; ///< Time spent fetching rows with next()
+        LatencyHistogram total;
+    };
+
+    struct SlowQuery
+    {
+        QDateTime timestamp;
+        QString sql;
+        qint64 prepareNs;
+        qint64 execNs;
+        qint64 stepNs;
+        qint64 rows;
+        QString plan; ///< EXPLAIN QUERY PLAN output, one step per line
+    };
+
+    static constexpr int SLOW_LOG_CAPACITY = 100;
+    static constexpr int DEFAULT_SLOW_THRESHOLD_MS = 50;
+
+    QueryStats();
+
+    /// Returns true when the statement was slower than the threshold
+    bool record(const QString &sql, qint64 prepareNs, qint64 execNs, qint64 stepNs, qint64 rows);
+    void addSlowQuery(SlowQuery query);
+
+    void setSlowThresholdMs(int milliseconds);
+    int slowThresholdMs() const;
+
+    /// Copies, sorted by total time spent in the statement
+    std::vector<StatementStats> statements() const;
+    std::vector<SlowQuery> slowQueries() const;
+
+    void reset();
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, StatementStats> m_statements;
+    std::deque<SlowQuery> m_slowQueries;
+    qint64 m_slowThresholdNs;
+};
+
+/**
+ * @brief QSqlQuery that reports its prepare, exec and step times to QueryStats
+ *
+ * A drop-in replacement for QSqlQuery in DatabaseManager. Each execution is
+ * recorded when the query is executed again or destroyed, so the step time
+ * covers every row read with next(). Slow executions are logged together
+ * with their EXPLAIN QUERY PLAN output.
+ */
+class TimedQuery : public QSqlQuery
+{
+public:
+    TimedQuery(const QSqlDatabase &database, QueryStats &stats);
+    ~TimedQuery();
+
+    TimedQuery(const TimedQuery &) = delete;
+    TimedQuery &operator=(const TimedQuery &) = delete;
+
+    bool prepare(const QString &query);
+    bool exec(const QString &query);
+    bool exec();
+    bool next();
+
+    /**
+     * @brief Record one execution that did not go through a TimedQuery
+     *
+     * Used for statements stepped through the sqlite3 C API. Slow ones are
+     * logged with their plan like a TimedQuery's.
+     */
+    static void record(QueryStats &stats, const QSqlDatabase &database, const QString &sql, qint64 prepareNs,
+                       qint64 execNs, qint64 stepNs, qint64 rows, const QVariantList &boundValues = QVariantList());
+
+private:
+    void flush();
+    static QString explainPlan(const QSqlDatabase &database, const QString &sql, const QVariantList &boundValues);
+
+    QSqlDatabase m_database;
+    QueryStats &m_stats;
+    QString m_sql;
+    qint64 m_prepareNs;
+    qint64 m_execNs;
+    qint64 m_stepNs;
+    qint64 m_rows;
+    bool m_pending;
+};
+
+#endif // QUERYSTATS_H
@@ -1,13 +1,18 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
 #include <QDir>
 #include <QStyleFactory>
 #include <QLoggingCategory>
 #include <iostream>
+#include <memory>
 
 #include "config/AppConfig.h"
 #include "config/LanguageManager.h"
 #include "ui/MainWindow.h"
+#include "utils/StallWatchdog.h"
+#include "utils/StartupReport.h"
+#include "utils/Trace.h"
 
 void msgHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
@@ -43,8 +48,25 @@ void msgHandler(QtMsgType type, const QMessageLogContext &context, const QString
         abort();
 }
 
+/// Where to write the trace on exit, empty when tracing is off. ECIM_TRACE overrides the config.
+QString traceOutputPath()
+{
+    QString path = qEnvironmentVariable("ECIM_TRACE");
+    if (path == "0")
+        return QString();
+    if (path == "1")
+        return "trace.json";
+    if (!path.isEmpty())
+        return path;
+
+    auto settings = Config.settings();
+    return settings->traceEnabled ? settings->traceFile : QString();
+}
+
 int main(int argc, char *argv[])
 {
+    StartupReport::instance().start();
+
     // Enable debug logging for our application
     QLoggingCategory::setFilterRules(
         "default.debug=true\n"
@@ -62,12 +84,47 @@ int main(int argc, char *argv[])
 
     QApplication app(argc, argv);
 
+    // Everything up to here is logging setup and Qt platform initialisation
+    StartupReport &startupReport = StartupReport::instance();
+    startupReport.record("QApplication", 0, 0, startupReport.elapsedNs());
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption startupReportOption("startup-report",
+                                           "Print a breakdown of startup phase timings once the inventory is loaded.");
+    QCommandLineOption startupReportJsonOption("startup-report-json",
+                                               "Also write the startup report as JSON to <file>.", "file");
+    parser.addOption(startupReportOption);
+    parser.addOption(startupReportJsonOption);
+    parser.process(app);
+
+    startupReport.setEnabled(parser.isSet(startupReportOption) || parser.isSet(startupReportJsonOption));
+    startupReport.setJsonPath(parser.value(startupReportJsonOption));
+
     AppConfig &config = AppConfig::instance();
-    config.load("config.json");
+    {
+        ScopedTimer timer("AppConfig::load");
+        config.load("config.json");
+    }
+    app.setApplicationName(config.appName());
+    app.setApplicationVersion(config.appVersion());
+    app.setOrganizationName(config.organizationName());
+
+    Trace::setEnabled(!traceOutputPath().isEmpty());
+    StallWatchdog::instance().start(config.settings()->stallMs);
+    QObject::connect(&config, &AppConfig::configChanged, [](AppConfig::ChangedFields fields)
+                     {
+                         if (fields & AppConfig::DiagnosticsChanged)
+                         {
+                             Trace::setEnabled(!traceOutputPath().isEmpty());
+                             StallWatchdog::instance().start(Config.settings()->stallMs);
+                         }
+                     });
 
     QString langFile = config.languageFile();
     if (!langFile.isEmpty())
     {
+        ScopedTimer timer("LanguageManager::loadLanguage");
         if (!Lang.loadLanguage(langFile))
         {
             qWarning() << "Failed to load language file:" << langFile;
@@ -80,8 +137,26 @@ int main(int argc, char *argv[])
 
     qDebug() << "Working directory:" << QDir::currentPath();
 
-    MainWindow mainWindow;
-    mainWindow.show();
+    std::unique_ptr<MainWindow> mainWindow;
+    {
+        ScopedTimer timer("MainWindow");
+        mainWindow = std::make_unique<MainWindow>();
+    }
+    {
+        ScopedTimer timer("MainWindow::show");
+        mainWindow->show();
+    }
 
-    return app.exec();
+    int result = app.exec();
+
+    StallWatchdog::instance().logSummary();
+    StallWatchdog::instance().stop();
+    mainWindow->saveSnapshot();
+
+    const QString tracePath = traceOutputPath();
+    if (!tracePath.isEmpty())
+    {
+        Trace::writeJson(tracePath);
+    }
+    return result;
 }
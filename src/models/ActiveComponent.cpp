@@ -9,7 +9,25 @@ ActiveComponent::ActiveComponent(int id, const QString &name, const QString &man
 
 ActiveComponent::~ActiveComponent() = default;
 
-QString ActiveComponent::getDetails() const
+void ActiveComponent::setOperatingVoltage(double voltage)
+{
+    m_operatingVoltage = voltage;
+    invalidateCache();
+}
+
+void ActiveComponent::setPinCount(int count)
+{
+    m_pinCount = count;
+    invalidateCache();
+}
+
+void ActiveComponent::setDatasheetLink(const QString &link)
+{
+    m_datasheetLink = link;
+    invalidateCache();
+}
+
+QString ActiveComponent::formatDetails() const
 {
     QString details = QString("%1V, %2 pins")
                           .arg(m_operatingVoltage, 0, 'f', 1)
@@ -23,6 +41,16 @@ QString ActiveComponent::getDetails() const
     return details;
 }
 
+QString ActiveComponent::formatParam1Display() const
+{
+    return QString("%1V").arg(m_operatingVoltage, 0, 'f', 1);
+}
+
+QString ActiveComponent::formatParam2Display() const
+{
+    return QString("%1 pins").arg(m_pinCount);
+}
+
 QString ActiveComponent::getType() const
 {
     return m_category;
@@ -30,7 +58,9 @@ QString ActiveComponent::getType() const
 
 std::unique_ptr<Component> ActiveComponent::clone() const
 {
-    return std::make_unique<ActiveComponent>(
+    auto copy = std::make_unique<ActiveComponent>(
         m_id, m_name, m_manufacturer, m_quantity, m_category,
         m_operatingVoltage, m_pinCount, m_datasheetLink);
+    copy->setMinStock(m_minStock);
+    return copy;
 }
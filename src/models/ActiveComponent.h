@@ -22,7 +22,6 @@ public:
 
     ~ActiveComponent() override;
 
-    QString getDetails() const override;
     QString getType() const override;
     double getParam1() const override { return m_operatingVoltage; }
     QString getParam2() const override { return QString::number(m_pinCount); }
@@ -32,9 +31,14 @@ public:
     int getPinCount() const { return m_pinCount; }
     QString getDatasheetLink() const { return m_datasheetLink; }
 
-    void setOperatingVoltage(double voltage) { m_operatingVoltage = voltage; }
-    void setPinCount(int count) { m_pinCount = count; }
-    void setDatasheetLink(const QString &link) { m_datasheetLink = link; }
+    void setOperatingVoltage(double voltage);
+    void setPinCount(int count);
+    void setDatasheetLink(const QString &link);
+
+protected:
+    QString formatDetails() const override;
+    QString formatParam1Display() const override;
+    QString formatParam2Display() const override;
 
 private:
     double m_operatingVoltage;
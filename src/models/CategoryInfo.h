@@ -7,22 +7,29 @@ class CategoryInfo
 {
 public:
     CategoryInfo()
-        : m_id(-1), m_isPassive(false), m_isActive(false) {}
+        : m_id(-1), m_isPassive(false), m_isActive(false), m_lowStockThreshold(-1) {}
 
-    CategoryInfo(int id, const QString &name, bool isPassive, bool isActive, const QString &defaultUnit = QString())
-        : m_id(id), m_name(name), m_isPassive(isPassive), m_isActive(isActive), m_defaultUnit(defaultUnit) {}
+    /**
+     * @param lowStockThreshold Reorder point for this category, -1 to use the global default
+     */
+    CategoryInfo(int id, const QString &name, bool isPassive, bool isActive, const QString &defaultUnit = QString(),
+                 int lowStockThreshold = -1)
+        : m_id(id), m_name(name), m_isPassive(isPassive), m_isActive(isActive), m_defaultUnit(defaultUnit), m_lowStockThreshold(lowStockThreshold) {}
 
     int id() const { return m_id; }
     QString name() const { return m_name; }
     bool isPassive() const { return m_isPassive; }
     bool isActive() const { return m_isActive; }
     QString defaultUnit() const { return m_defaultUnit; }
+    int lowStockThreshold() const { return m_lowStockThreshold; }
+    bool hasLowStockThreshold() const { return m_lowStockThreshold >= 0; }
 
     void setId(int id) { m_id = id; }
     void setName(const QString &name) { m_name = name; }
     void setIsPassive(bool passive) { m_isPassive = passive; }
     void setIsActive(bool active) { m_isActive = active; }
     void setDefaultUnit(const QString &unit) { m_defaultUnit = unit; }
+    void setLowStockThreshold(int threshold) { m_lowStockThreshold = threshold; }
 
     bool isValid() const { return m_id >= 0 && !m_name.isEmpty(); }
 
@@ -32,6 +39,7 @@ private:
     bool m_isPassive;
     bool m_isActive;
     QString m_defaultUnit;
+    int m_lowStockThreshold;
 };
 
 #endif // CATEGORYINFO_H
@@ -0,0 +1,44 @@
+#include "models/CategoryRegistry.h"
+
+CategoryRegistry::CategoryRegistry()
+    : m_categories(1), m_thresholds(1, 0), m_defaultThreshold(0)
+{
+}
+
+void CategoryRegistry::rebuild(const std::vector<CategoryInfo> &categories, int defaultThreshold)
+{
+    m_categories.clear();
+    m_categories.reserve(categories.size() + 1);
+    m_categories.emplace_back(); // UNKNOWN_SLOT
+
+    m_slotByName.clear();
+    m_slotByName.reserve(static_cast<qsizetype>(categories.size()));
+
+    for (const auto &category : categories)
+    {
+        m_slotByName.insert(category.name(), static_cast<int>(m_categories.size()));
+        m_categories.push_back(category);
+    }
+
+    m_defaultThreshold = defaultThreshold;
+    updateThresholds();
+}
+
+void CategoryRegistry::setDefaultThreshold(int threshold)
+{
+    if (threshold == m_defaultThreshold)
+        return;
+
+    m_defaultThreshold = threshold;
+    updateThresholds();
+}
+
+void CategoryRegistry::updateThresholds()
+{
+    m_thresholds.resize(m_categories.size());
+    for (size_t slot = 0; slot < m_categories.size(); ++slot)
+    {
+        const CategoryInfo &category = m_categories[slot];
+        m_thresholds[slot] = category.hasLowStockThreshold() ? category.lowStockThreshold() : m_defaultThreshold;
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef CATEGORYREGISTRY_H
+#define CATEGORYREGISTRY_H
+
+#include <QHash>
+#include <QString>
+#include <vector>
+#include "models/CategoryInfo.h"
+
+/**
+ * @brief In-memory lookup table of categories and their low stock thresholds
+ *
+ * Categories are stored in flat slots. Resolving a name to a slot is a
+ * single hash probe, done once when a row is loaded. Threshold lookups
+ * after that are plain array indexing. Slot 0 stands for unknown
+ * categories and always uses the default threshold.
+ */
+class CategoryRegistry
+{
+public:
+    static constexpr int UNKNOWN_SLOT = 0;
+
+    CategoryRegistry();
+
+    /**
+     * @param categories Categories as loaded from the database
+     * @param defaultThreshold Threshold for categories without their own
+     */
+    void rebuild(const std::vector<CategoryInfo> &categories, int defaultThreshold);
+    void setDefaultThreshold(int threshold);
+
+    int slotOf(const QString &name) const { return m_slotByName.value(name, UNKNOWN_SLOT); }
+    const CategoryInfo &categoryAt(int slot) const { return m_categories[slot]; }
+    int thresholdAt(int slot) const { return m_thresholds[slot]; }
+
+    int defaultThreshold() const { return m_defaultThreshold; }
+    int size() const { return static_cast<int>(m_categories.size()); }
+
+private:
+    void updateThresholds();
+
+    std::vector<CategoryInfo> m_categories;
+    std::vector<int> m_thresholds;
+    QHash<QString, int> m_slotByName;
+    int m_defaultThreshold;
+};
+
+#endif // CATEGORYREGISTRY_H
@@ -1,15 +1,88 @@
 #include "models/Component.h"
-#include "config/AppConfig.h"
 
 Component::Component(int id, const QString &name, const QString &manufacturer,
                      int quantity, const QString &category)
-    : m_id(id), m_name(name), m_manufacturer(manufacturer), m_quantity(quantity), m_category(category)
+    : m_id(id), m_name(name), m_manufacturer(manufacturer), m_quantity(quantity), m_category(category), m_minStock(-1)
 {
 }
 
 Component::~Component() = default;
 
-bool Component::isLowStock() const
+void Component::setName(const QString &name)
 {
-    return m_quantity < AppConfig::instance().lowStockThreshold();
+    m_name = name;
+    invalidateCache();
+}
+
+void Component::setManufacturer(const QString &manufacturer)
+{
+    m_manufacturer = manufacturer;
+    invalidateCache();
+}
+
+void Component::setQuantity(int quantity)
+{
+    m_quantity = quantity;
+    invalidateCache();
+}
+
+void Component::setCategory(const QString &category)
+{
+    m_category = category;
+    invalidateCache();
+}
+
+QString Component::getDetails() const
+{
+    if (!(m_cachedFields & CachedDetails))
+    {
+        m_detailsCache = formatDetails();
+        m_cachedFields |= CachedDetails;
+    }
+    return m_detailsCache;
+}
+
+QString Component::getParam1Display() const
+{
+    if (!(m_cachedFields & CachedParam1))
+    {
+        m_param1Cache = formatParam1Display();
+        m_cachedFields |= CachedParam1;
+    }
+    return m_param1Cache;
+}
+
+QString Component::getParam2Display() const
+{
+    if (!(m_cachedFields & CachedParam2))
+    {
+        m_param2Cache = formatParam2Display();
+        m_cachedFields |= CachedParam2;
+    }
+    return m_param2Cache;
+}
+
+QString Component::getLowStockWarning() const
+{
+    if (!(m_cachedFields & CachedLowStockWarning))
+    {
+        m_lowStockWarningCache = QString("Low Stock Warning: Only %1 units remaining!").arg(m_quantity);
+        m_cachedFields |= CachedLowStockWarning;
+    }
+    return m_lowStockWarningCache;
+}
+
+QString Component::formatParam1Display() const
+{
+    return QString::number(getParam1());
+}
+
+QString Component::formatParam2Display() const
+{
+    return getParam2();
+}
+
+void Component::invalidateCache()
+{
+    m_cachedFields = 0;
 }
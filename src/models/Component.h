@@ -25,7 +25,6 @@ public:
 
     virtual ~Component();
 
-    virtual QString getDetails() const = 0;
     virtual QString getType() const = 0;
     virtual double getParam1() const = 0;
     virtual QString getParam2() const = 0;
@@ -37,21 +36,58 @@ public:
     QString getManufacturer() const { return m_manufacturer; }
     int getQuantity() const { return m_quantity; }
     QString getCategory() const { return m_category; }
+    int getMinStock() const { return m_minStock; }
+    bool hasMinStock() const { return m_minStock >= 0; }
 
     void setId(int id) { m_id = id; }
-    void setName(const QString &name) { m_name = name; }
-    void setManufacturer(const QString &manufacturer) { m_manufacturer = manufacturer; }
-    void setQuantity(int quantity) { m_quantity = quantity; }
-    void setCategory(const QString &category) { m_category = category; }
+    void setName(const QString &name);
+    void setManufacturer(const QString &manufacturer);
+    void setQuantity(int quantity);
+    void setCategory(const QString &category);
+    void setMinStock(int minStock) { m_minStock = minStock; }
 
-    bool isLowStock() const;
+    /// Per-component override wins over the category threshold
+    int effectiveThreshold(int categoryThreshold) const { return m_minStock >= 0 ? m_minStock : categoryThreshold; }
+    bool isLowStock(int categoryThreshold) const { return m_quantity < effectiveThreshold(categoryThreshold); }
+
+    /**
+     * Display strings are formatted on first use and kept until one of the
+     * setters changes a field they depend on.
+     */
+    QString getDetails() const;
+    QString getParam1Display() const;
+    QString getParam2Display() const;
+    QString getLowStockWarning() const;
 
 protected:
+    virtual QString formatDetails() const = 0;
+    virtual QString formatParam1Display() const;
+    virtual QString formatParam2Display() const;
+
+    /// Must be called by every setter that changes a displayed field
+    virtual void invalidateCache();
+
     int m_id;
     QString m_name;
     QString m_manufacturer;
     int m_quantity;
     QString m_category;
+    int m_minStock; // -1 inherits the category threshold
+
+private:
+    enum CachedField : quint8
+    {
+        CachedDetails = 0x1,
+        CachedParam1 = 0x2,
+        CachedParam2 = 0x4,
+        CachedLowStockWarning = 0x8
+    };
+
+    mutable QString m_detailsCache;
+    mutable QString m_param1Cache;
+    mutable QString m_param2Cache;
+    mutable QString m_lowStockWarningCache;
+    mutable quint8 m_cachedFields = 0;
 };
 
 #endif // COMPONENT_H
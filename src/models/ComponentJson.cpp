@@ -0,0 +1,69 @@
+#include "models/ComponentJson.h"
+#include "models/ActiveComponent.h"
+#include "models/PassiveComponent.h"
+#include <QJsonValue>
+
+QJsonObject ComponentJson::toJson(const Component &component)
+{
+    QJsonObject json;
+    json["id"] = component.getId();
+    json["name"] = component.getName();
+    json["manufacturer"] = component.getManufacturer();
+    json["category"] = component.getCategory();
+    json["quantity"] = component.getQuantity();
+    json["minStock"] = component.hasMinStock() ? QJsonValue(component.getMinStock()) : QJsonValue();
+
+    if (auto *passive = dynamic_cast<const PassiveComponent *>(&component))
+    {
+        json["value"] = passive->getValue();
+        json["unit"] = passive->getUnit();
+        json["package"] = passive->getPackage();
+    }
+    else if (auto *active = dynamic_cast<const ActiveComponent *>(&component))
+    {
+        json["voltage"] = active->getOperatingVoltage();
+        json["pins"] = active->getPinCount();
+        json["datasheet"] = active->getDatasheetLink();
+    }
+    return json;
+}
+
+std::unique_ptr<Component> ComponentJson::fromJson(const QJsonObject &json, const CategoryRegistry &registry,
+                                                   QString *error)
+{
+    QString name = json.value("name").toString();
+    QString category = json.value("category").toString();
+    if (name.isEmpty() || category.isEmpty())
+    {
+        if (error)
+            *error = "name and category are required";
+        return nullptr;
+    }
+
+    int id = json.value("id").toInt(-1);
+    QString manufacturer = json.value("manufacturer").toString();
+    int quantity = qMax(0, json.value("quantity").toInt());
+
+    std::unique_ptr<Component> component;
+    if (registry.categoryAt(registry.slotOf(category)).isActive())
+    {
+        component = std::make_unique<ActiveComponent>(
+            id, name, manufacturer, quantity, category,
+            json.value("voltage").toDouble(),
+            json.value("pins").toInt(),
+            json.value("datasheet").toString());
+    }
+    else
+    {
+        // Passive, and the fallback for unknown categories as in hydrateComponent
+        component = std::make_unique<PassiveComponent>(
+            id, name, manufacturer, quantity, category,
+            json.value("value").toDouble(),
+            json.value("unit").toString(),
+            json.value("package").toString());
+    }
+
+    QJsonValue minStock = json.value("minStock");
+    component->setMinStock(minStock.isDouble() ? qMax(0, minStock.toInt()) : -1);
+    return component;
+}
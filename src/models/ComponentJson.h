@@ -0,0 +1,35 @@
+#ifndef COMPONENTJSON_H
+#define COMPONENTJSON_H
+
+#include <QJsonObject>
+#include <QString>
+#include <memory>
+#include "models/Component.h"
+#include "models/CategoryRegistry.h"
+
+/**
+ * @brief JSON form of a component, used by the command line tool and exporters
+ *
+ * Passive parts carry value, unit and package; active parts carry voltage,
+ * pins and datasheet. minStock is null when the category threshold applies.
+ */
+class ComponentJson
+{
+public:
+    static QJsonObject toJson(const Component &component);
+
+    /**
+     * @brief Build a component from its JSON form
+     *
+     * The category decides between passive and active, as when loading
+     * from the database. id is optional and defaults to -1.
+     * @return nullptr with error set if name or category is missing
+     */
+    static std::unique_ptr<Component> fromJson(const QJsonObject &json, const CategoryRegistry &registry,
+                                               QString *error = nullptr);
+
+private:
+    ComponentJson() = delete;
+};
+
+#endif // COMPONENTJSON_H
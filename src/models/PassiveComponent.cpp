@@ -1,5 +1,5 @@
 #include "models/PassiveComponent.h"
-#include <cmath>
+#include "utils/SiValue.h"
 
 PassiveComponent::PassiveComponent(int id, const QString &name, const QString &manufacturer,
                                    int quantity, const QString &category,
@@ -10,7 +10,31 @@ PassiveComponent::PassiveComponent(int id, const QString &name, const QString &m
 
 PassiveComponent::~PassiveComponent() = default;
 
-QString PassiveComponent::getDetails() const
+void PassiveComponent::setValue(double value)
+{
+    m_value = value;
+    invalidateCache();
+}
+
+void PassiveComponent::setUnit(const QString &unit)
+{
+    m_unit = unit;
+    invalidateCache();
+}
+
+void PassiveComponent::setPackage(const QString &package)
+{
+    m_package = package;
+    invalidateCache();
+}
+
+void PassiveComponent::invalidateCache()
+{
+    Component::invalidateCache();
+    m_formattedValue = QString();
+}
+
+QString PassiveComponent::formatDetails() const
 {
     return QString("%1 %2, Package: %3, Qty: %4")
         .arg(getFormattedValue())
@@ -26,45 +50,28 @@ QString PassiveComponent::getType() const
 
 std::unique_ptr<Component> PassiveComponent::clone() const
 {
-    return std::make_unique<PassiveComponent>(
+    auto copy = std::make_unique<PassiveComponent>(
         m_id, m_name, m_manufacturer, m_quantity, m_category,
         m_value, m_unit, m_package);
+    copy->setMinStock(m_minStock);
+    return copy;
+}
+
+QString PassiveComponent::formatParam1Display() const
+{
+    return getFormattedValue() + m_unit;
+}
+
+QString PassiveComponent::formatParam2Display() const
+{
+    return m_package;
 }
 
 QString PassiveComponent::getFormattedValue() const
 {
-    // Format value with SI prefixes
-    if (m_value >= 1e9)
-    {
-        return QString::number(m_value / 1e9, 'g', 3) + "G";
-    }
-    else if (m_value >= 1e6)
-    {
-        return QString::number(m_value / 1e6, 'g', 3) + "M";
-    }
-    else if (m_value >= 1e3)
-    {
-        return QString::number(m_value / 1e3, 'g', 3) + "k";
-    }
-    else if (m_value >= 1)
-    {
-        return QString::number(m_value, 'g', 3);
-    }
-    else if (m_value >= 1e-3)
-    {
-        return QString::number(m_value * 1e3, 'g', 3) + "m";
-    }
-    else if (m_value >= 1e-6)
-    {
-        return QString::number(m_value * 1e6, 'g', 3) + "μ";
-    }
-    else if (m_value >= 1e-9)
-    {
-        return QString::number(m_value * 1e9, 'g', 3) + "n";
-    }
-    else if (m_value >= 1e-12)
+    if (m_formattedValue.isNull())
     {
-        return QString::number(m_value * 1e12, 'g', 3) + "p";
+        m_formattedValue = SiValue::toString(m_value);
     }
-    return QString::number(m_value, 'g', 3);
+    return m_formattedValue;
 }
@@ -22,7 +22,6 @@ public:
 
     ~PassiveComponent() override;
 
-    QString getDetails() const override;
     QString getType() const override;
     double getParam1() const override { return m_value; }
     QString getParam2() const override { return m_package; }
@@ -32,16 +31,24 @@ public:
     QString getUnit() const { return m_unit; }
     QString getPackage() const { return m_package; }
 
-    void setValue(double value) { m_value = value; }
-    void setUnit(const QString &unit) { m_unit = unit; }
-    void setPackage(const QString &package) { m_package = package; }
+    void setValue(double value);
+    void setUnit(const QString &unit);
+    void setPackage(const QString &package);
 
     QString getFormattedValue() const;
 
+protected:
+    QString formatDetails() const override;
+    QString formatParam1Display() const override;
+    QString formatParam2Display() const override;
+    void invalidateCache() override;
+
 private:
     double m_value;
     QString m_unit;
     QString m_package;
+
+    mutable QString m_formattedValue; // Null until first formatted
 };
 
 #endif // PASSIVECOMPONENT_H
@@ -1,5 +1,6 @@
 #include "ui/CategoryDialog.h"
 #include "config/LanguageManager.h"
+#include "utils/Trace.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -10,9 +11,10 @@
 #include <QMessageBox>
 
 CategoryDialog::CategoryDialog(QWidget *parent)
-    : QDialog(parent), m_nameEdit(nullptr), m_passiveCheck(nullptr), m_activeCheck(nullptr), m_unitEdit(nullptr), m_okButton(nullptr), m_cancelButton(nullptr), m_categoryId(-1), m_isBuiltInCategory(false)
+    : QDialog(parent), m_nameEdit(nullptr), m_passiveCheck(nullptr), m_activeCheck(nullptr), m_unitEdit(nullptr), m_thresholdSpin(nullptr), m_okButton(nullptr), m_cancelButton(nullptr), m_categoryId(-1), m_isBuiltInCategory(false)
 {
-    setWindowTitle(Lang.translate("menu.category.title"));
+    TRACE_SCOPE("ui", "CategoryDialog::CategoryDialog");
+    setWindowTitle(Lang.translate(TrKey::MenuCategoryTitle));
     setMinimumWidth(400);
     setModal(true);
 
@@ -27,47 +29,60 @@ void CategoryDialog::setupUi()
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
     // Basic info group
-    QGroupBox *basicGroup = new QGroupBox(Lang.translate("dialog.category.categoryInfo"), this);
+    QGroupBox *basicGroup = new QGroupBox(Lang.translate(TrKey::DialogCategoryCategoryInfo), this);
     QFormLayout *basicForm = new QFormLayout(basicGroup);
 
     m_nameEdit = new QLineEdit(this);
-    m_nameEdit->setPlaceholderText(Lang.translate("dialog.category.namePlaceholder"));
-    basicForm->addRow(Lang.translate("dialog.category.nameLabel"), m_nameEdit);
+    m_nameEdit->setPlaceholderText(Lang.translate(TrKey::DialogCategoryNamePlaceholder));
+    basicForm->addRow(Lang.translate(TrKey::DialogCategoryNameLabel), m_nameEdit);
 
     mainLayout->addWidget(basicGroup);
 
     // Type group
-    QGroupBox *typeGroup = new QGroupBox(Lang.translate("dialog.category.componentType"), this);
+    QGroupBox *typeGroup = new QGroupBox(Lang.translate(TrKey::DialogCategoryComponentType), this);
     QVBoxLayout *typeLayout = new QVBoxLayout(typeGroup);
 
-    QLabel *typeInfo = new QLabel(Lang.translate("dialog.category.typeInfo"), typeGroup);
+    QLabel *typeInfo = new QLabel(Lang.translate(TrKey::DialogCategoryTypeInfo), typeGroup);
     typeInfo->setWordWrap(true);
     typeLayout->addWidget(typeInfo);
 
-    m_passiveCheck = new QCheckBox(Lang.translate("dialog.category.passiveCheck"), this);
+    m_passiveCheck = new QCheckBox(Lang.translate(TrKey::DialogCategoryPassiveCheck), this);
     typeLayout->addWidget(m_passiveCheck);
 
-    m_activeCheck = new QCheckBox(Lang.translate("dialog.category.activeCheck"), this);
+    m_activeCheck = new QCheckBox(Lang.translate(TrKey::DialogCategoryActiveCheck), this);
     typeLayout->addWidget(m_activeCheck);
 
     QLabel *noteLabel = new QLabel(
-        QString("<i>%1</i>").arg(Lang.translate("dialog.category.typeNote")), typeGroup);
+        QString("<i>%1</i>").arg(Lang.translate(TrKey::DialogCategoryTypeNote)), typeGroup);
     noteLabel->setWordWrap(true);
     typeLayout->addWidget(noteLabel);
 
     mainLayout->addWidget(typeGroup);
 
     // Unit group (for passive)
-    QGroupBox *unitGroup = new QGroupBox(Lang.translate("dialog.category.defaultUnit"), this);
+    QGroupBox *unitGroup = new QGroupBox(Lang.translate(TrKey::DialogCategoryDefaultUnit), this);
     QFormLayout *unitForm = new QFormLayout(unitGroup);
 
     m_unitEdit = new QLineEdit(this);
-    m_unitEdit->setPlaceholderText(Lang.translate("dialog.category.unitPlaceholder"));
+    m_unitEdit->setPlaceholderText(Lang.translate(TrKey::DialogCategoryUnitPlaceholder));
     m_unitEdit->setMaxLength(10);
-    unitForm->addRow(Lang.translate("dialog.category.unitLabel"), m_unitEdit);
+    unitForm->addRow(Lang.translate(TrKey::DialogCategoryUnitLabel), m_unitEdit);
 
     mainLayout->addWidget(unitGroup);
 
+    // Stock group
+    QGroupBox *stockGroup = new QGroupBox(Lang.translate(TrKey::DialogCategoryStockGroup), this);
+    QFormLayout *stockForm = new QFormLayout(stockGroup);
+
+    // -1 means the category follows the global threshold from the config
+    m_thresholdSpin = new QSpinBox(this);
+    m_thresholdSpin->setRange(-1, 999999);
+    m_thresholdSpin->setValue(-1);
+    m_thresholdSpin->setSpecialValueText(Lang.translate(TrKey::DialogCategoryUseDefaultThreshold));
+    stockForm->addRow(Lang.translate(TrKey::DialogCategoryThresholdLabel), m_thresholdSpin);
+
+    mainLayout->addWidget(stockGroup);
+
     // Button box
     QDialogButtonBox *buttonBox = new QDialogButtonBox(
         QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
@@ -92,12 +107,14 @@ void CategoryDialog::onTypeChanged()
 
 void CategoryDialog::setCategory(const CategoryInfo &category)
 {
+    TRACE_SCOPE("ui", "CategoryDialog::setCategory");
     m_categoryId = category.id();
     m_nameEdit->setText(category.name());
     m_passiveCheck->setChecked(category.isPassive());
     m_activeCheck->setChecked(category.isActive());
     m_unitEdit->setText(category.defaultUnit());
     m_unitEdit->setEnabled(category.isPassive());
+    m_thresholdSpin->setValue(category.lowStockThreshold());
 }
 
 void CategoryDialog::setSystemCategory(bool isBuiltIn)
@@ -113,20 +130,22 @@ void CategoryDialog::setSystemCategory(bool isBuiltIn)
 
 CategoryInfo CategoryDialog::getCategory() const
 {
+    TRACE_SCOPE("ui", "CategoryDialog::getCategory");
     return CategoryInfo(
         m_categoryId,
         m_nameEdit->text().trimmed(),
         m_passiveCheck->isChecked(),
         m_activeCheck->isChecked(),
-        m_unitEdit->text().trimmed());
+        m_unitEdit->text().trimmed(),
+        m_thresholdSpin->value());
 }
 
 bool CategoryDialog::validateInputs()
 {
     if (m_nameEdit->text().trimmed().isEmpty())
     {
-        QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
-                             Lang.translate("dialog.category.nameRequired"));
+        QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
+                             Lang.translate(TrKey::DialogCategoryNameRequired));
         m_nameEdit->setFocus();
         return false;
     }
@@ -139,7 +158,7 @@ bool CategoryDialog::validateInputs()
                                 "Transistor", "Diode", "Connector", "Other"};
         if (reserved.contains(name, Qt::CaseInsensitive))
         {
-            QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
+            QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
                                  QString("'%1' is a reserved category name.").arg(name));
             m_nameEdit->setFocus();
             return false;
@@ -151,6 +170,7 @@ bool CategoryDialog::validateInputs()
 
 void CategoryDialog::validateAndAccept()
 {
+    TRACE_SCOPE("ui", "CategoryDialog::validateAndAccept");
     if (validateInputs())
     {
         accept();
@@ -6,6 +6,7 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QPushButton>
+#include <QSpinBox>
 #include "models/CategoryInfo.h"
 
 class CategoryDialog : public QDialog
@@ -33,6 +34,7 @@ private:
     QCheckBox *m_passiveCheck;
     QCheckBox *m_activeCheck;
     QLineEdit *m_unitEdit;
+    QSpinBox *m_thresholdSpin;
     QPushButton *m_okButton;
     QPushButton *m_cancelButton;
 
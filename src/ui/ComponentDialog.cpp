@@ -3,6 +3,8 @@
 #include "models/ActiveComponent.h"
 #include "database/DatabaseManager.h"
 #include "config/LanguageManager.h"
+#include "utils/SiValue.h"
+#include "utils/Trace.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -14,9 +16,10 @@
 #include <QDialogButtonBox>
 
 ComponentDialog::ComponentDialog(QWidget *parent)
-    : QDialog(parent), m_nameEdit(nullptr), m_manufacturerEdit(nullptr), m_categoryCombo(nullptr), m_quantitySpin(nullptr), m_stackedWidget(nullptr), m_valueSpin(nullptr), m_valueMultiplier(nullptr), m_packageEdit(nullptr), m_voltageSpin(nullptr), m_pinCountSpin(nullptr), m_datasheetEdit(nullptr), m_okButton(nullptr), m_cancelButton(nullptr)
+    : QDialog(parent), m_nameEdit(nullptr), m_manufacturerEdit(nullptr), m_categoryCombo(nullptr), m_quantitySpin(nullptr), m_minStockSpin(nullptr), m_stackedWidget(nullptr), m_valueSpin(nullptr), m_valueMultiplier(nullptr), m_packageEdit(nullptr), m_voltageSpin(nullptr), m_pinCountSpin(nullptr), m_datasheetEdit(nullptr), m_okButton(nullptr), m_cancelButton(nullptr)
 {
-    setWindowTitle(Lang.translate("menu.component.title"));
+    TRACE_SCOPE("ui", "ComponentDialog::ComponentDialog");
+    setWindowTitle(Lang.translate(TrKey::MenuComponentTitle));
     setMinimumWidth(450);
     setModal(true);
 
@@ -34,16 +37,16 @@ void ComponentDialog::setupUi()
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
     // Common fields group
-    QGroupBox *commonGroup = new QGroupBox(Lang.translate("dialog.component.basicInfo"), this);
+    QGroupBox *commonGroup = new QGroupBox(Lang.translate(TrKey::DialogComponentBasicInfo), this);
     QFormLayout *commonForm = new QFormLayout(commonGroup);
 
     m_nameEdit = new QLineEdit(this);
-    m_nameEdit->setPlaceholderText(Lang.translate("dialog.component.namePlaceholder"));
-    commonForm->addRow(Lang.translate("dialog.component.nameLabel"), m_nameEdit);
+    m_nameEdit->setPlaceholderText(Lang.translate(TrKey::DialogComponentNamePlaceholder));
+    commonForm->addRow(Lang.translate(TrKey::DialogComponentNameLabel), m_nameEdit);
 
     m_manufacturerEdit = new QLineEdit(this);
-    m_manufacturerEdit->setPlaceholderText(Lang.translate("dialog.component.manufacturerPlaceholder"));
-    commonForm->addRow(Lang.translate("dialog.component.manufacturerLabel"), m_manufacturerEdit);
+    m_manufacturerEdit->setPlaceholderText(Lang.translate(TrKey::DialogComponentManufacturerPlaceholder));
+    commonForm->addRow(Lang.translate(TrKey::DialogComponentManufacturerLabel), m_manufacturerEdit);
 
     m_categoryCombo = new QComboBox(this);
     // Load categories from database
@@ -52,13 +55,20 @@ void ComponentDialog::setupUi()
     {
         m_categoryCombo->addItem(cat.name());
     }
-    commonForm->addRow(Lang.translate("dialog.component.categoryLabel"), m_categoryCombo);
+    commonForm->addRow(Lang.translate(TrKey::DialogComponentCategoryLabel), m_categoryCombo);
 
     m_quantitySpin = new QSpinBox(this);
     m_quantitySpin->setRange(0, 999999);
     m_quantitySpin->setValue(0);
-    m_quantitySpin->setSuffix(Lang.translate("dialog.component.unitsSuffix"));
-    commonForm->addRow(Lang.translate("dialog.component.quantityLabel"), m_quantitySpin);
+    m_quantitySpin->setSuffix(Lang.translate(TrKey::DialogComponentUnitsSuffix));
+    commonForm->addRow(Lang.translate(TrKey::DialogComponentQuantityLabel), m_quantitySpin);
+
+    // -1 means the component uses its category's threshold
+    m_minStockSpin = new QSpinBox(this);
+    m_minStockSpin->setRange(-1, 999999);
+    m_minStockSpin->setValue(-1);
+    m_minStockSpin->setSpecialValueText(Lang.translate(TrKey::DialogComponentMinStockDefault));
+    commonForm->addRow(Lang.translate(TrKey::DialogComponentMinStockLabel), m_minStockSpin);
 
     mainLayout->addWidget(commonGroup);
 
@@ -66,7 +76,7 @@ void ComponentDialog::setupUi()
     m_stackedWidget = new QStackedWidget(this);
 
     // Page 0: Passive component fields
-    QGroupBox *passiveGroup = new QGroupBox(Lang.translate("dialog.component.passiveParams"), this);
+    QGroupBox *passiveGroup = new QGroupBox(Lang.translate(TrKey::DialogComponentPassiveParams), this);
     QFormLayout *passiveForm = new QFormLayout(passiveGroup);
 
     QHBoxLayout *valueLayout = new QHBoxLayout();
@@ -76,52 +86,49 @@ void ComponentDialog::setupUi()
     m_valueSpin->setValue(1.0);
     valueLayout->addWidget(m_valueSpin);
 
+    // Combo indices match SiValue::PREFIXES
     m_valueMultiplier = new QComboBox(this);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.pico"), 1e-12);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.nano"), 1e-9);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.micro"), 1e-6);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.milli"), 1e-3);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.base"), 1.0);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.kilo"), 1e3);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.mega"), 1e6);
-    m_valueMultiplier->addItem(Lang.translate("multipliers.giga"), 1e9);
-    m_valueMultiplier->setCurrentIndex(4); // Default to base
+    for (const SiValue::Prefix &prefix : SiValue::PREFIXES)
+    {
+        m_valueMultiplier->addItem(Lang.translate(prefix.translationKey), prefix.scale);
+    }
+    m_valueMultiplier->setCurrentIndex(SiValue::BASE_PREFIX);
     valueLayout->addWidget(m_valueMultiplier);
 
     QWidget *valueWidget = new QWidget(this);
     valueWidget->setLayout(valueLayout);
-    passiveForm->addRow(Lang.translate("dialog.component.valueLabel"), valueWidget);
+    passiveForm->addRow(Lang.translate(TrKey::DialogComponentValueLabel), valueWidget);
 
     m_packageEdit = new QLineEdit(this);
-    passiveForm->addRow(Lang.translate("dialog.component.packageLabel"), m_packageEdit);
+    passiveForm->addRow(Lang.translate(TrKey::DialogComponentPackageLabel), m_packageEdit);
 
     m_stackedWidget->addWidget(passiveGroup);
 
     // Page 1: Active component fields
-    QGroupBox *activeGroup = new QGroupBox(Lang.translate("dialog.component.activeParams"), this);
+    QGroupBox *activeGroup = new QGroupBox(Lang.translate(TrKey::DialogComponentActiveParams), this);
     QFormLayout *activeForm = new QFormLayout(activeGroup);
 
     m_voltageSpin = new QDoubleSpinBox(this);
     m_voltageSpin->setRange(0.1, 1000.0);
     m_voltageSpin->setDecimals(1);
     m_voltageSpin->setValue(5.0);
-    m_voltageSpin->setSuffix(Lang.translate("dialog.component.voltageSuffix"));
-    activeForm->addRow(Lang.translate("dialog.component.voltageLabel"), m_voltageSpin);
+    m_voltageSpin->setSuffix(Lang.translate(TrKey::DialogComponentVoltageSuffix));
+    activeForm->addRow(Lang.translate(TrKey::DialogComponentVoltageLabel), m_voltageSpin);
 
     m_pinCountSpin = new QSpinBox(this);
     m_pinCountSpin->setRange(1, 500);
     m_pinCountSpin->setValue(8);
-    m_pinCountSpin->setSuffix(Lang.translate("dialog.component.pinsSuffix"));
-    activeForm->addRow(Lang.translate("dialog.component.pinCountLabel"), m_pinCountSpin);
+    m_pinCountSpin->setSuffix(Lang.translate(TrKey::DialogComponentPinsSuffix));
+    activeForm->addRow(Lang.translate(TrKey::DialogComponentPinCountLabel), m_pinCountSpin);
 
     m_datasheetEdit = new QLineEdit(this);
-    m_datasheetEdit->setPlaceholderText(Lang.translate("dialog.component.datasheetPlaceholder"));
-    activeForm->addRow(Lang.translate("dialog.component.datasheetLabel"), m_datasheetEdit);
+    m_datasheetEdit->setPlaceholderText(Lang.translate(TrKey::DialogComponentDatasheetPlaceholder));
+    activeForm->addRow(Lang.translate(TrKey::DialogComponentDatasheetLabel), m_datasheetEdit);
 
     m_stackedWidget->addWidget(activeGroup);
 
     // Page 2: Generic (Connector, Other)
-    QGroupBox *otherGroup = new QGroupBox(Lang.translate("dialog.component.otherParams"), this);
+    QGroupBox *otherGroup = new QGroupBox(Lang.translate(TrKey::DialogComponentOtherParams), this);
     QFormLayout *otherForm = new QFormLayout(otherGroup);
 
     QLabel *infoLabel = new QLabel("No additional parameters required for this category.", this);
@@ -174,6 +181,7 @@ void ComponentDialog::updateFieldsForCategory(const CategoryInfo &catInfo)
 
 void ComponentDialog::setComponent(const Component *component)
 {
+    TRACE_SCOPE("ui", "ComponentDialog::setComponent");
     if (!component)
         return;
 
@@ -181,6 +189,7 @@ void ComponentDialog::setComponent(const Component *component)
     m_nameEdit->setText(component->getName());
     m_manufacturerEdit->setText(component->getManufacturer());
     m_quantitySpin->setValue(component->getQuantity());
+    m_minStockSpin->setValue(component->getMinStock());
 
     // Set category
     int catIndex = m_categoryCombo->findText(component->getCategory());
@@ -192,51 +201,11 @@ void ComponentDialog::setComponent(const Component *component)
     // Set type-specific fields
     if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
     {
-        double value = passive->getValue();
+        // Spin box shows 3 decimals of a mantissa below 1000
+        double mantissa = 0.0;
+        int multiplierIndex = SiValue::decompose(passive->getValue(), mantissa, 6);
 
-        // Find appropriate multiplier
-        int multiplierIndex = 4; // base
-        if (value >= 1e9)
-        {
-            value /= 1e9;
-            multiplierIndex = 7;
-        }
-        else if (value >= 1e6)
-        {
-            value /= 1e6;
-            multiplierIndex = 6;
-        }
-        else if (value >= 1e3)
-        {
-            value /= 1e3;
-            multiplierIndex = 5;
-        }
-        else if (value >= 1)
-        {
-            multiplierIndex = 4;
-        }
-        else if (value >= 1e-3)
-        {
-            value *= 1e3;
-            multiplierIndex = 3;
-        }
-        else if (value >= 1e-6)
-        {
-            value *= 1e6;
-            multiplierIndex = 2;
-        }
-        else if (value >= 1e-9)
-        {
-            value *= 1e9;
-            multiplierIndex = 1;
-        }
-        else
-        {
-            value *= 1e12;
-            multiplierIndex = 0;
-        }
-
-        m_valueSpin->setValue(value);
+        m_valueSpin->setValue(mantissa);
         m_valueMultiplier->setCurrentIndex(multiplierIndex);
 
         m_packageEdit->setText(passive->getPackage());
@@ -251,6 +220,7 @@ void ComponentDialog::setComponent(const Component *component)
 
 std::unique_ptr<Component> ComponentDialog::getComponent() const
 {
+    TRACE_SCOPE("ui", "ComponentDialog::getComponent");
     QString name = m_nameEdit->text().trimmed();
     QString manufacturer = m_manufacturerEdit->text().trimmed();
     int quantity = m_quantitySpin->value();
@@ -258,6 +228,7 @@ std::unique_ptr<Component> ComponentDialog::getComponent() const
 
     CategoryInfo catInfo = DatabaseManager::instance().fetchCategoryByName(categoryName);
 
+    std::unique_ptr<Component> component;
     if (catInfo.isPassive())
     {
         double value = m_valueSpin->value();
@@ -267,7 +238,7 @@ std::unique_ptr<Component> ComponentDialog::getComponent() const
         QString unit = catInfo.defaultUnit();
         QString package = m_packageEdit->text().trimmed();
 
-        return std::make_unique<PassiveComponent>(
+        component = std::make_unique<PassiveComponent>(
             -1, name, manufacturer, quantity, categoryName,
             value, unit, package);
     }
@@ -277,17 +248,20 @@ std::unique_ptr<Component> ComponentDialog::getComponent() const
         int pinCount = m_pinCountSpin->value();
         QString datasheet = m_datasheetEdit->text().trimmed();
 
-        return std::make_unique<ActiveComponent>(
+        component = std::make_unique<ActiveComponent>(
             -1, name, manufacturer, quantity, categoryName,
             voltage, pinCount, datasheet);
     }
     else
     {
         // For Connector/Other or custom categories, create a passive component with minimal data
-        return std::make_unique<PassiveComponent>(
+        component = std::make_unique<PassiveComponent>(
             -1, name, manufacturer, quantity, categoryName,
             0.0, "", "");
     }
+
+    component->setMinStock(m_minStockSpin->value());
+    return component;
 }
 
 bool ComponentDialog::validateInputs()
@@ -295,8 +269,8 @@ bool ComponentDialog::validateInputs()
     // Name is required
     if (m_nameEdit->text().trimmed().isEmpty())
     {
-        QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
-                             Lang.translate("dialog.component.nameRequired"));
+        QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
+                             Lang.translate(TrKey::DialogComponentNameRequired));
         m_nameEdit->setFocus();
         return false;
     }
@@ -304,8 +278,8 @@ bool ComponentDialog::validateInputs()
     // Quantity cannot be negative (already enforced by spinbox, but double-check)
     if (m_quantitySpin->value() < 0)
     {
-        QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
-                             Lang.translate("dialog.component.quantityNegative"));
+        QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
+                             Lang.translate(TrKey::DialogComponentQuantityNegative));
         m_quantitySpin->setFocus();
         return false;
     }
@@ -317,14 +291,14 @@ bool ComponentDialog::validateInputs()
     {
         if (m_valueSpin->value() <= 0)
         {
-            QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
+            QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
                                  "Please enter a positive component value.");
             m_valueSpin->setFocus();
             return false;
         }
         if (m_packageEdit->text().trimmed().isEmpty())
         {
-            QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
+            QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
                                  "Please select or enter a package type.");
             m_packageEdit->setFocus();
             return false;
@@ -336,14 +310,14 @@ bool ComponentDialog::validateInputs()
     {
         if (m_voltageSpin->value() <= 0)
         {
-            QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
+            QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
                                  "Please enter a positive operating voltage.");
             m_voltageSpin->setFocus();
             return false;
         }
         if (m_pinCountSpin->value() < 1)
         {
-            QMessageBox::warning(this, Lang.translate("dialog.component.validationError"),
+            QMessageBox::warning(this, Lang.translate(TrKey::DialogComponentValidationError),
                                  "Pin count must be at least 1.");
             m_pinCountSpin->setFocus();
             return false;
@@ -355,6 +329,7 @@ bool ComponentDialog::validateInputs()
 
 void ComponentDialog::validateAndAccept()
 {
+    TRACE_SCOPE("ui", "ComponentDialog::validateAndAccept");
     if (validateInputs())
     {
         accept();
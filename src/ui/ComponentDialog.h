@@ -37,6 +37,7 @@ private:
     QLineEdit *m_manufacturerEdit;
     QComboBox *m_categoryCombo;
     QSpinBox *m_quantitySpin;
+    QSpinBox *m_minStockSpin;
 
     QStackedWidget *m_stackedWidget;
 
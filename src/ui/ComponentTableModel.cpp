@@ -1,14 +1,60 @@
 #include "ui/ComponentTableModel.h"
-#include "models/PassiveComponent.h"
-#include "models/ActiveComponent.h"
 #include "database/DatabaseManager.h"
+#include "config/AppConfig.h"
 #include "config/LanguageManager.h"
+#include "utils/AllocCounter.h"
+#include "utils/SiValue.h"
+#include "utils/Trace.h"
 #include <QColor>
 #include <QFont>
+#include <algorithm>
+
+namespace
+{
+    // Shared role values; copying these into a QVariant return only bumps a refcount
+    const QVariant &lowStockBackground()
+    {
+        static const QVariant value = QVariant::fromValue(QColor(255, 230, 230)); // Light red/pink background
+        return value;
+    }
+
+    const QVariant &lowStockForeground()
+    {
+        static const QVariant value = QVariant::fromValue(QColor(180, 0, 0)); // Dark red text
+        return value;
+    }
+
+    const QVariant &lowStockFont()
+    {
+        static const QVariant value = []()
+        {
+            QFont font;
+            font.setBold(true);
+            return QVariant::fromValue(font);
+        }();
+        return value;
+    }
+
+    const QVariant &columnAlignmentVariant(int column)
+    {
+        static const std::array<QVariant, ComponentTableModel::ColumnCount> values = []()
+        {
+            std::array<QVariant, ComponentTableModel::ColumnCount> result;
+            for (int i = 0; i < ComponentTableModel::ColumnCount; ++i)
+            {
+                result[i] = static_cast<int>(ComponentTableModel::columnAlignment(i));
+            }
+            return result;
+        }();
+        return values[column];
+    }
+}
 
 ComponentTableModel::ComponentTableModel(QObject *parent)
     : QAbstractTableModel(parent)
 {
+    connect(&AppConfig::instance(), &AppConfig::configChanged,
+            this, &ComponentTableModel::onConfigChanged);
 }
 
 ComponentTableModel::~ComponentTableModel() = default;
@@ -33,93 +79,34 @@ int ComponentTableModel::columnCount(const QModelIndex &parent) const
 
 QVariant ComponentTableModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() >= static_cast<int>(m_components.size()))
+    // Hot path: everything below is served from m_rows without formatting or allocating
+    ALLOC_BUDGET("ComponentTableModel::data", 0);
+    if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size()) || index.column() >= ColumnCount)
     {
         return QVariant();
     }
 
-    const auto &component = m_components[index.row()];
-
-    // Custom role for low stock indication
-    if (role == LowStockRole)
-    {
-        return component->isLowStock();
-    }
-
-    if (role == Qt::DisplayRole)
-    {
-        switch (index.column())
-        {
-        case ColId:
-            return component->getId();
-        case ColName:
-            return component->getName();
-        case ColCategory:
-            return component->getCategory();
-        case ColManufacturer:
-            return component->getManufacturer();
-        case ColQuantity:
-            return component->getQuantity();
-        case ColValue:
-            return getParam1Display(component.get());
-        case ColPackage:
-            return getParam2Display(component.get());
-        case ColDetails:
-            return component->getDetails();
-        }
-    }
-
-    if (role == Qt::TextAlignmentRole)
-    {
-        switch (index.column())
-        {
-        case ColId:
-        case ColQuantity:
-            return static_cast<int>(Qt::AlignCenter);
-        case ColValue:
-            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
-        default:
-            return static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter);
-        }
-    }
-
-    if (role == Qt::BackgroundRole)
-    {
-        if (component->isLowStock())
-        {
-            return QColor(255, 230, 230); // Light red/pink background
-        }
-    }
-
-    if (role == Qt::ForegroundRole)
-    {
-        if (component->isLowStock())
-        {
-            return QColor(180, 0, 0); // Dark red text
-        }
-    }
-
-    if (role == Qt::FontRole)
-    {
-        if (component->isLowStock())
-        {
-            QFont font;
-            font.setBold(true);
-            return font;
-        }
-    }
+    const RowCache &row = m_rows[index.row()];
 
-    if (role == Qt::ToolTipRole)
+    switch (role)
     {
-        if (component->isLowStock())
-        {
-            return QString("Low Stock Warning: Only %1 units remaining!")
-                .arg(component->getQuantity());
-        }
-        return component->getDetails();
+    case Qt::DisplayRole:
+        return row.display[index.column()];
+    case LowStockRole:
+        return row.lowStock;
+    case Qt::TextAlignmentRole:
+        return columnAlignmentVariant(index.column());
+    case Qt::BackgroundRole:
+        return row.lowStock ? lowStockBackground() : QVariant();
+    case Qt::ForegroundRole:
+        return row.lowStock ? lowStockForeground() : QVariant();
+    case Qt::FontRole:
+        return row.lowStock ? lowStockFont() : QVariant();
+    case Qt::ToolTipRole:
+        return row.toolTip;
+    default:
+        return QVariant();
     }
-
-    return QVariant();
 }
 
 QVariant ComponentTableModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -134,19 +121,19 @@ QVariant ComponentTableModel::headerData(int section, Qt::Orientation orientatio
         switch (section)
         {
         case ColId:
-            return Lang.translate("table.columns.id");
+            return Lang.translate(TrKey::TableColumnsId);
         case ColName:
-            return Lang.translate("table.columns.name");
+            return Lang.translate(TrKey::TableColumnsName);
         case ColCategory:
-            return Lang.translate("table.columns.category");
+            return Lang.translate(TrKey::TableColumnsCategory);
         case ColManufacturer:
-            return Lang.translate("table.columns.manufacturer");
+            return Lang.translate(TrKey::TableColumnsManufacturer);
         case ColQuantity:
-            return Lang.translate("table.columns.quantity");
+            return Lang.translate(TrKey::TableColumnsQuantity);
         case ColValue:
-            return Lang.translate("table.columns.value");
+            return Lang.translate(TrKey::TableColumnsValue);
         case ColPackage:
-            return Lang.translate("table.columns.package");
+            return Lang.translate(TrKey::TableColumnsPackage);
         case ColDetails:
             return "Details";
         }
@@ -161,8 +148,10 @@ QVariant ComponentTableModel::headerData(int section, Qt::Orientation orientatio
 
 void ComponentTableModel::setComponents(std::vector<std::unique_ptr<Component>> &&components)
 {
+    TRACE_SCOPE("model", "ComponentTableModel::setComponents");
     beginResetModel();
     m_components = std::move(components);
+    rebuildRowCache();
     endResetModel();
 }
 
@@ -170,6 +159,7 @@ void ComponentTableModel::addComponent(std::unique_ptr<Component> component)
 {
     int row = static_cast<int>(m_components.size());
     beginInsertRows(QModelIndex(), row, row);
+    m_rows.push_back(buildRowCache(component.get()));
     m_components.push_back(std::move(component));
     endInsertRows();
 }
@@ -185,6 +175,7 @@ bool ComponentTableModel::updateComponent(const Component *component)
         {
             // Clone the new data
             m_components[i] = component->clone();
+            m_rows[i] = buildRowCache(m_components[i].get());
 
             // Emit data changed for entire row
             QModelIndex topLeft = createIndex(static_cast<int>(i), 0);
@@ -204,6 +195,7 @@ bool ComponentTableModel::removeComponent(int id)
         {
             beginRemoveRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
             m_components.erase(m_components.begin() + i);
+            m_rows.erase(m_rows.begin() + i);
             endRemoveRows();
             return true;
         }
@@ -234,8 +226,10 @@ const Component *ComponentTableModel::getComponentById(int id) const
 
 void ComponentTableModel::refresh()
 {
+    TRACE_SCOPE("model", "ComponentTableModel::refresh");
     beginResetModel();
     m_components = DatabaseManager::instance().fetchAllComponents();
+    rebuildRowCache();
     endResetModel();
 }
 
@@ -255,31 +249,141 @@ void ComponentTableModel::clear()
 {
     beginResetModel();
     m_components.clear();
+    m_rows.clear();
+    reloadCategoryRegistry();
     endResetModel();
 }
 
-QString ComponentTableModel::getParam1Display(const Component *component) const
+void ComponentTableModel::appendComponents(std::vector<std::unique_ptr<Component>> &&components)
 {
-    if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
+    TRACE_SCOPE("model", "ComponentTableModel::appendComponents");
+    if (components.empty())
     {
-        return passive->getFormattedValue() + passive->getUnit();
+        return;
     }
-    else if (auto *active = dynamic_cast<const ActiveComponent *>(component))
+
+    int first = static_cast<int>(m_components.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(components.size()) - 1);
+    m_components.reserve(m_components.size() + components.size());
+    m_rows.reserve(m_rows.size() + components.size());
+    for (auto &component : components)
     {
-        return QString("%1V").arg(active->getOperatingVoltage(), 0, 'f', 1);
+        m_rows.push_back(buildRowCache(component.get()));
+        m_components.push_back(std::move(component));
     }
-    return QString::number(component->getParam1());
+    endInsertRows();
 }
 
-QString ComponentTableModel::getParam2Display(const Component *component) const
+void ComponentTableModel::onConfigChanged(AppConfig::ChangedFields fields)
 {
-    if (auto *passive = dynamic_cast<const PassiveComponent *>(component))
+    if (!(fields & AppConfig::LowStockThresholdChanged))
     {
-        return passive->getPackage();
+        return;
     }
-    else if (auto *active = dynamic_cast<const ActiveComponent *>(component))
+
+    m_categoryRegistry.setDefaultThreshold(Config.settings()->lowStockThreshold);
+    updateLowStockFlags();
+}
+
+void ComponentTableModel::updateLowStockFlags()
+{
+    TRACE_SCOPE("model", "ComponentTableModel::updateLowStockFlags");
+    // Rows already know their category slot, so this is one array lookup per row
+    for (size_t i = 0; i < m_rows.size(); ++i)
     {
-        return QString("%1 pins").arg(active->getPinCount());
+        RowCache &row = m_rows[i];
+        const Component *component = m_components[i].get();
+
+        row.threshold = component->effectiveThreshold(m_categoryRegistry.thresholdAt(row.categorySlot));
+        bool lowStock = row.quantity < row.threshold;
+        if (lowStock != row.lowStock)
+        {
+            row.lowStock = lowStock;
+            row.toolTip = buildToolTip(component, lowStock);
+        }
     }
-    return component->getParam2();
+
+    if (!m_rows.empty())
+    {
+        emit dataChanged(index(0, 0), index(static_cast<int>(m_rows.size()) - 1, ColumnCount - 1));
+    }
+}
+
+ComponentTableModel::RowCache ComponentTableModel::buildRowCache(const Component *component) const
+{
+    RowCache row;
+    row.display[ColId] = component->getId();
+    row.display[ColName] = component->getName();
+    row.display[ColCategory] = component->getCategory();
+    row.display[ColManufacturer] = component->getManufacturer();
+    row.display[ColQuantity] = component->getQuantity();
+    row.display[ColValue] = component->getParam1Display();
+    row.display[ColPackage] = component->getParam2Display();
+    row.display[ColDetails] = component->getDetails();
+    for (int column = 0; column < ColumnCount; ++column)
+    {
+        row.text[column] = row.display[column].toString();
+    }
+    row.quantity = component->getQuantity();
+    row.categorySlot = m_categoryRegistry.slotOf(component->getCategory());
+    row.threshold = component->effectiveThreshold(m_categoryRegistry.thresholdAt(row.categorySlot));
+    row.lowStock = row.quantity < row.threshold;
+    row.toolTip = buildToolTip(component, row.lowStock);
+    return row;
+}
+
+void ComponentTableModel::reloadCategoryRegistry()
+{
+    m_categoryRegistry = DatabaseManager::instance().categoryRegistry();
+    m_categoryRegistry.setDefaultThreshold(Config.settings()->lowStockThreshold);
+}
+
+void ComponentTableModel::rebuildRowCache()
+{
+    TRACE_SCOPE("model", "ComponentTableModel::rebuildRowCache");
+    // Pick up category threshold changes along with the new rows
+    reloadCategoryRegistry();
+
+    m_rows.clear();
+    m_rows.reserve(m_components.size());
+    for (const auto &component : m_components)
+    {
+        m_rows.push_back(buildRowCache(component.get()));
+    }
+}
+
+QVariant ComponentTableModel::buildToolTip(const Component *component, bool lowStock) const
+{
+    return lowStock ? component->getLowStockWarning() : component->getDetails();
+}
+
+Qt::Alignment ComponentTableModel::columnAlignment(int column)
+{
+    switch (column)
+    {
+    case ColId:
+    case ColQuantity:
+        return Qt::AlignCenter;
+    case ColValue:
+        return Qt::AlignRight | Qt::AlignVCenter;
+    default:
+        return Qt::AlignLeft | Qt::AlignVCenter;
+    }
+}
+
+QRegularExpression ComponentTableModel::searchExpression(const QString &text)
+{
+    QString pattern = text;
+
+    // Let values typed as "4k7" or "100nF" also match the formatted value column
+    double value = 0.0;
+    QStringView unit;
+    bool hasPrefixOrUnit = std::any_of(text.cbegin(), text.cend(), [](QChar c)
+                                       { return c.isLetter(); });
+    if (hasPrefixOrUnit && SiValue::parse(text, value, &unit))
+    {
+        pattern += "|" + QRegularExpression::escape(SiValue::toString(value) + unit.toString());
+    }
+
+    return QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption);
 }
@@ -2,9 +2,14 @@
 #define COMPONENTTABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <QRegularExpression>
+#include <QVariant>
+#include <array>
 #include <memory>
 #include <vector>
 #include "models/Component.h"
+#include "models/CategoryRegistry.h"
+#include "config/AppConfig.h"
 
 class ComponentTableModel : public QAbstractTableModel
 {
@@ -25,6 +30,23 @@ public:
         ColumnCount
     };
 
+    /**
+     * @brief Values served by data() for one row, built when the row changes
+     *
+     * Keeping these ready means a repaint only copies implicitly shared
+     * QVariants instead of formatting strings or querying the config.
+     */
+    struct RowCache
+    {
+        std::array<QVariant, ColumnCount> display;
+        std::array<QString, ColumnCount> text;
+        QVariant toolTip;
+        int quantity = 0;
+        int categorySlot = CategoryRegistry::UNKNOWN_SLOT;
+        int threshold = 0; // Effective reorder point for this row
+        bool lowStock = false;
+    };
+
     explicit ComponentTableModel(QObject *parent = nullptr);
     ~ComponentTableModel() override;
 
@@ -35,6 +57,9 @@ public:
                         int role = Qt::DisplayRole) const override;
 
     void setComponents(std::vector<std::unique_ptr<Component>> &&components);
+
+    /// Append rows as one insert, used when streaming the inventory in batches
+    void appendComponents(std::vector<std::unique_ptr<Component>> &&components);
     void addComponent(std::unique_ptr<Component> component);
     bool updateComponent(const Component *component);
     bool removeComponent(int id);
@@ -48,14 +73,35 @@ public:
 
     int componentCount() const { return static_cast<int>(m_components.size()); }
 
+    /// Cached row values for delegates that paint without going through data()
+    const RowCache &rowCache(int row) const { return m_rows[row]; }
+
+    static Qt::Alignment columnAlignment(int column);
+
+    /**
+     * @brief Filter for text typed into the search box
+     *
+     * The text is used as a pattern as typed. Values such as "4k7" or
+     * "100nF" also match the formatted value column.
+     */
+    static QRegularExpression searchExpression(const QString &text);
+
     /// Custom role for low stock indication
     static constexpr int LowStockRole = Qt::UserRole + 1;
 
+private slots:
+    void onConfigChanged(AppConfig::ChangedFields fields);
+
 private:
     std::vector<std::unique_ptr<Component>> m_components;
+    std::vector<RowCache> m_rows;
+    CategoryRegistry m_categoryRegistry;
 
-    QString getParam1Display(const Component *component) const;
-    QString getParam2Display(const Component *component) const;
+    RowCache buildRowCache(const Component *component) const;
+    void reloadCategoryRegistry();
+    void rebuildRowCache();
+    void updateLowStockFlags();
+    QVariant buildToolTip(const Component *component, bool lowStock) const;
 };
 
 #endif // COMPONENTTABLEMODEL_H
@@ -0,0 +1,211 @@
+#include "ui/DiagnosticsDialog.h"
+#include "config/LanguageManager.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QSplitter>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace
+{
+    enum StatementColumn
+    {
+        ColStatement = 0,
+        ColRuns,
+        ColRows,
+        ColP50,
+        ColP99,
+        ColMax,
+        ColExecP99,
+        ColStepP99,
+        StatementColumnCount
+    };
+
+    QString milliseconds(qint64 ns)
+    {
+        return QString::number(static_cast<double>(ns) / 1e6, 'f', 3);
+    }
+
+    QTableWidgetItem *numberItem(const QString &text)
+    {
+        auto *item = new QTableWidgetItem(text);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    }
+}
+
+DiagnosticsDialog::DiagnosticsDialog(QueryStats &stats, QWidget *parent)
+    : QDialog(parent), m_stats(stats), m_tabs(nullptr), m_statementTable(nullptr), m_thresholdLabel(nullptr), m_slowQueryList(nullptr), m_slowQueryDetail(nullptr), m_eventLoopLabel(nullptr), m_stallList(nullptr), m_refreshButton(nullptr), m_resetButton(nullptr), m_closeButton(nullptr)
+{
+    setWindowTitle(Lang.translate(TrKey::DialogDiagnosticsTitle));
+    setMinimumSize(800, 450);
+
+    setupUi();
+    setupConnections();
+    refresh();
+}
+
+DiagnosticsDialog::~DiagnosticsDialog() = default;
+
+void DiagnosticsDialog::setupUi()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    m_tabs = new QTabWidget(this);
+
+    // Query latency
+    m_statementTable = new QTableWidget(0, StatementColumnCount, this);
+    m_statementTable->setHorizontalHeaderLabels({Lang.translate(TrKey::DialogDiagnosticsColumnStatement),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnRuns),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnRows),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnP50),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnP99),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnMax),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnExecP99),
+                                                 Lang.translate(TrKey::DialogDiagnosticsColumnStepP99)});
+    m_statementTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_statementTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_statementTable->setWordWrap(false);
+    m_statementTable->verticalHeader()->setVisible(false);
+    m_statementTable->horizontalHeader()->setSectionResizeMode(ColStatement, QHeaderView::Stretch);
+    m_tabs->addTab(m_statementTable, Lang.translate(TrKey::DialogDiagnosticsQueriesTab));
+
+    // Slow queries
+    QWidget *slowPage = new QWidget(this);
+    QVBoxLayout *slowLayout = new QVBoxLayout(slowPage);
+    m_thresholdLabel = new QLabel(slowPage);
+    slowLayout->addWidget(m_thresholdLabel);
+
+    QSplitter *splitter = new QSplitter(Qt::Vertical, slowPage);
+    m_slowQueryList = new QListWidget(splitter);
+    m_slowQueryDetail = new QPlainTextEdit(splitter);
+    m_slowQueryDetail->setReadOnly(true);
+    m_slowQueryDetail->setFont(QFont("monospace"));
+    splitter->addWidget(m_slowQueryList);
+    splitter->addWidget(m_slowQueryDetail);
+    slowLayout->addWidget(splitter);
+    m_tabs->addTab(slowPage, Lang.translate(TrKey::DialogDiagnosticsSlowQueriesTab));
+
+    // Event loop
+    QWidget *eventLoopPage = new QWidget(this);
+    QVBoxLayout *eventLoopLayout = new QVBoxLayout(eventLoopPage);
+    m_eventLoopLabel = new QLabel(eventLoopPage);
+    eventLoopLayout->addWidget(m_eventLoopLabel);
+    m_stallList = new QListWidget(eventLoopPage);
+    eventLoopLayout->addWidget(m_stallList);
+    m_tabs->addTab(eventLoopPage, Lang.translate(TrKey::DialogDiagnosticsEventLoopTab));
+
+    mainLayout->addWidget(m_tabs);
+
+    // Buttons
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_refreshButton = new QPushButton(Lang.translate(TrKey::DialogDiagnosticsRefresh), this);
+    m_resetButton = new QPushButton(Lang.translate(TrKey::DialogDiagnosticsReset), this);
+    m_closeButton = new QPushButton(Lang.translate(TrKey::DialogDiagnosticsClose), this);
+    buttonLayout->addWidget(m_refreshButton);
+    buttonLayout->addWidget(m_resetButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_closeButton);
+    mainLayout->addLayout(buttonLayout);
+}
+
+void DiagnosticsDialog::setupConnections()
+{
+    connect(m_refreshButton, &QPushButton::clicked, this, &DiagnosticsDialog::refresh);
+    connect(m_resetButton, &QPushButton::clicked, this, &DiagnosticsDialog::reset);
+    connect(m_closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    connect(m_slowQueryList, &QListWidget::currentRowChanged, this, &DiagnosticsDialog::onSlowQuerySelected);
+}
+
+void DiagnosticsDialog::refresh()
+{
+    const std::vector<QueryStats::StatementStats> statements = m_stats.statements();
+    m_statementTable->setRowCount(static_cast<int>(statements.size()));
+    for (int row = 0; row < static_cast<int>(statements.size()); ++row)
+    {
+        const QueryStats::StatementStats &stats = statements[row];
+
+        auto *statementItem = new QTableWidgetItem(stats.sql.simplified());
+        statementItem->setToolTip(stats.sql);
+        m_statementTable->setItem(row, ColStatement, statementItem);
+        m_statementTable->setItem(row, ColRuns, numberItem(QString::number(stats.executions)));
+        m_statementTable->setItem(row, ColRows, numberItem(QString::number(stats.rows)));
+        m_statementTable->setItem(row, ColP50, numberItem(milliseconds(stats.total.percentile(50))));
+        m_statementTable->setItem(row, ColP99, numberItem(milliseconds(stats.total.percentile(99))));
+        m_statementTable->setItem(row, ColMax, numberItem(milliseconds(stats.total.max())));
+        m_statementTable->setItem(row, ColExecP99, numberItem(milliseconds(stats.exec.percentile(99))));
+        m_statementTable->setItem(row, ColStepP99, numberItem(milliseconds(stats.step.percentile(99))));
+    }
+
+    m_thresholdLabel->setText(Lang.translate(TrKey::DialogDiagnosticsSlowThreshold, QString::number(m_stats.slowThresholdMs()),
+                                             "Statements slower than %1 ms are logged with their query plan."));
+
+    // Newest first
+    m_slowQueries = m_stats.slowQueries();
+    std::reverse(m_slowQueries.begin(), m_slowQueries.end());
+    m_slowQueryList->clear();
+    m_slowQueryDetail->clear();
+    for (const auto &slow : m_slowQueries)
+    {
+        qint64 totalNs = slow.prepareNs + slow.execNs + slow.stepNs;
+        m_slowQueryList->addItem(Lang.translate(TrKey::DialogDiagnosticsSlowEntry,
+                                                QStringList{slow.timestamp.toString("HH:mm:ss"), milliseconds(totalNs), QString::number(slow.rows)},
+                                                "%1  %2 ms, %3 rows") +
+                                 "  " + slow.sql.simplified());
+    }
+
+    refreshEventLoop();
+}
+
+void DiagnosticsDialog::refreshEventLoop()
+{
+    StallWatchdog &watchdog = StallWatchdog::instance();
+    if (!watchdog.isRunning())
+    {
+        m_eventLoopLabel->setText(Lang.translate(TrKey::DialogDiagnosticsWatchdogDisabled));
+    }
+    else
+    {
+        LatencyHistogram latency = watchdog.latency();
+        m_eventLoopLabel->setText(
+            Lang.translate(TrKey::DialogDiagnosticsEventLoopLatency,
+                           QStringList{QString::number(latency.count()), milliseconds(latency.percentile(50)),
+                                       milliseconds(latency.percentile(99)), milliseconds(latency.max())},
+                           "Heartbeat latency over %1 beats: p50 %2 ms, p99 %3 ms, max %4 ms") +
+            "\n" +
+            Lang.translate(TrKey::DialogDiagnosticsStallCount,
+                           QStringList{QString::number(watchdog.stallCount()), QString::number(watchdog.stallThresholdMs())},
+                           "%1 stalls longer than %2 ms"));
+    }
+
+    // Newest first
+    std::vector<StallWatchdog::Stall> stalls = watchdog.stalls();
+    m_stallList->clear();
+    for (auto it = stalls.rbegin(); it != stalls.rend(); ++it)
+    {
+        m_stallList->addItem(Lang.translate(TrKey::DialogDiagnosticsStallEntry,
+                                            QStringList{it->timestamp.toString("HH:mm:ss"), milliseconds(it->durationNs), it->operation},
+                                            "%1  %2 ms in %3"));
+    }
+}
+
+void DiagnosticsDialog::reset()
+{
+    m_stats.reset();
+    refresh();
+}
+
+void DiagnosticsDialog::onSlowQuerySelected(int row)
+{
+    if (row < 0 || row >= static_cast<int>(m_slowQueries.size()))
+    {
+        m_slowQueryDetail->clear();
+        return;
+    }
+
+    const QueryStats::SlowQuery &slow = m_slowQueries[row];
+    m_slowQueryDetail->setPlainText(QString("%1\n\nprepare %2 ms, exec %3 ms, step %4 ms, %5 rows\n\nEXPLAIN QUERY PLAN\n%6")
+                                        .arg(slow.sql.trimmed(), milliseconds(slow.prepareNs), milliseconds(slow.execNs),
+                                             milliseconds(slow.stepNs), QString::number(slow.rows), slow.plan));
+}
@@ -0,0 +1,51 @@
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QListWidget>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTabWidget>
+#include <vector>
+#include "database/QueryStats.h"
+#include "utils/StallWatchdog.h"
+
+/**
+ * @brief Shows per-statement query latency, the slow query log and event loop stalls
+ */
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(QueryStats &stats, QWidget *parent = nullptr);
+    ~DiagnosticsDialog() override;
+
+private slots:
+    void refresh();
+    void reset();
+    void onSlowQuerySelected(int row);
+
+private:
+    void setupUi();
+    void setupConnections();
+    void refreshEventLoop();
+
+    QueryStats &m_stats;
+    std::vector<QueryStats::SlowQuery> m_slowQueries;
+
+    QTabWidget *m_tabs;
+    QTableWidget *m_statementTable;
+    QLabel *m_thresholdLabel;
+    QListWidget *m_slowQueryList;
+    QPlainTextEdit *m_slowQueryDetail;
+    QLabel *m_eventLoopLabel;
+    QListWidget *m_stallList;
+    QPushButton *m_refreshButton;
+    QPushButton *m_resetButton;
+    QPushButton *m_closeButton;
+};
+
+#endif // DIAGNOSTICSDIALOG_H
@@ -0,0 +1,137 @@
+#include "ui/InventoryItemDelegate.h"
+#include "ui/ComponentTableModel.h"
+
+#include <QAbstractProxyModel>
+#include <QApplication>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QStyleOption>
+
+InventoryItemDelegate::InventoryItemDelegate(const ComponentTableModel *model, QObject *parent)
+    : QStyledItemDelegate(parent), m_model(model), m_rowHeight(0), m_boldFont(QApplication::font()), m_lowStockBackground(255, 230, 230), m_lowStockText(180, 0, 0), m_barColor(80, 160, 80), m_lowStockBarColor(200, 40, 40)
+{
+    m_boldFont.setBold(true);
+    m_rowHeight = QFontMetrics(m_boldFont).height() + 2 * CELL_PADDING;
+}
+
+InventoryItemDelegate::~InventoryItemDelegate() = default;
+
+void InventoryItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                                  const QModelIndex &index) const
+{
+    int row = sourceRow(index);
+    if (row < 0)
+    {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    const ComponentTableModel::RowCache &cache = m_model->rowCache(row);
+    const int column = index.column();
+    const bool selected = option.state & QStyle::State_Selected;
+    const QPalette::ColorGroup group = (option.state & QStyle::State_Active) ? QPalette::Active : QPalette::Inactive;
+
+    painter->save();
+
+    // Background
+    if (selected)
+    {
+        painter->fillRect(option.rect, option.palette.brush(group, QPalette::Highlight));
+    }
+    else if (cache.lowStock)
+    {
+        painter->fillRect(option.rect, m_lowStockBackground);
+    }
+    else if (option.features & QStyleOptionViewItem::Alternate)
+    {
+        painter->fillRect(option.rect, option.palette.brush(group, QPalette::AlternateBase));
+    }
+
+    if (column == ComponentTableModel::ColQuantity)
+    {
+        paintQuantityBar(painter, option.rect, cache);
+    }
+
+    // Text
+    if (selected)
+    {
+        painter->setPen(option.palette.color(group, QPalette::HighlightedText));
+    }
+    else if (cache.lowStock)
+    {
+        painter->setPen(m_lowStockText);
+    }
+    else
+    {
+        painter->setPen(option.palette.color(group, QPalette::Text));
+    }
+    painter->setFont(cache.lowStock ? m_boldFont : option.font);
+
+    const QString &text = cache.text[column];
+    const QRect textRect = option.rect.adjusted(CELL_PADDING, 0, -CELL_PADDING, 0);
+    const Qt::Alignment alignment = ComponentTableModel::columnAlignment(column);
+    const QFontMetrics metrics = painter->fontMetrics();
+
+    // Only elide when the text doesn't fit, eliding always builds a new string
+    if (metrics.horizontalAdvance(text) > textRect.width())
+    {
+        painter->drawText(textRect, alignment | Qt::TextSingleLine,
+                          metrics.elidedText(text, Qt::ElideRight, textRect.width()));
+    }
+    else
+    {
+        painter->drawText(textRect, alignment | Qt::TextSingleLine, text);
+    }
+
+    painter->restore();
+
+    // Current cell indicator for keyboard navigation, as QStyledItemDelegate draws it
+    if (option.state & QStyle::State_HasFocus)
+    {
+        QStyleOptionFocusRect focusOption;
+        focusOption.QStyleOption::operator=(option);
+        focusOption.rect = option.rect;
+        focusOption.state |= QStyle::State_KeyboardFocusChange | QStyle::State_Item;
+        focusOption.backgroundColor = option.palette.color(group, selected ? QPalette::Highlight : QPalette::Window);
+        QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+        style->drawPrimitive(QStyle::PE_FrameFocusRect, &focusOption, painter, option.widget);
+    }
+}
+
+QSize InventoryItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(index);
+    return QSize(option.rect.width(), m_rowHeight);
+}
+
+int InventoryItemDelegate::sourceRow(const QModelIndex &index) const
+{
+    QModelIndex source = index;
+    if (auto *proxy = qobject_cast<const QAbstractProxyModel *>(index.model()))
+    {
+        source = proxy->mapToSource(index);
+    }
+
+    if (source.model() != m_model || source.row() < 0 || source.row() >= m_model->componentCount())
+    {
+        return -1;
+    }
+    return source.row();
+}
+
+void InventoryItemDelegate::paintQuantityBar(QPainter *painter, const QRect &rect,
+                                             const ComponentTableModel::RowCache &cache) const
+{
+    int fullScale = qMax(1, cache.threshold * BAR_FULL_SCALE);
+    double fraction = qBound(0.0, static_cast<double>(cache.quantity) / fullScale, 1.0);
+
+    int maxWidth = rect.width() - 2 * CELL_PADDING;
+    int width = static_cast<int>(maxWidth * fraction);
+    if (width <= 0)
+    {
+        return;
+    }
+
+    QRect bar(rect.left() + CELL_PADDING, rect.bottom() - BAR_HEIGHT - 1, width, BAR_HEIGHT);
+    painter->fillRect(bar, cache.lowStock ? m_lowStockBarColor : m_barColor);
+}
@@ -0,0 +1,53 @@
+#ifndef INVENTORYITEMDELEGATE_H
+#define INVENTORYITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QColor>
+#include <QFont>
+#include "ui/ComponentTableModel.h"
+
+/**
+ * @brief Lightweight delegate for the inventory table
+ *
+ * Paints cells directly from ComponentTableModel's row cache instead of
+ * querying the model for every role and initializing a full style option.
+ * All rows share one fixed height, so no size hints are computed.
+ */
+class InventoryItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param model Source model whose cached rows are painted
+     * @param parent Owning object (usually the table view)
+     */
+    explicit InventoryItemDelegate(const ComponentTableModel *model, QObject *parent = nullptr);
+    ~InventoryItemDelegate() override;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    /// Uniform row height for the view's vertical header
+    int rowHeight() const { return m_rowHeight; }
+
+private:
+    int sourceRow(const QModelIndex &index) const;
+    void paintQuantityBar(QPainter *painter, const QRect &rect, const ComponentTableModel::RowCache &cache) const;
+
+    const ComponentTableModel *m_model;
+    int m_rowHeight;
+    QFont m_boldFont;
+
+    const QColor m_lowStockBackground;
+    const QColor m_lowStockText;
+    const QColor m_barColor;
+    const QColor m_lowStockBarColor;
+
+    static constexpr int CELL_PADDING = 4;
+    static constexpr int BAR_HEIGHT = 3;
+    static constexpr int BAR_FULL_SCALE = 4; // Bar is full at this multiple of the row's threshold
+};
+
+#endif // INVENTORYITEMDELEGATE_H
@@ -4,10 +4,16 @@
 #include "ui/CategoryDialog.h"
 #include "ui/ComponentTableModel.h"
 #include "ui/ComponentDialog.h"
+#include "ui/DiagnosticsDialog.h"
+#include "ui/InventoryItemDelegate.h"
 
+#include "database/ComponentExporter.h"
+#include "database/CsvImporter.h"
 #include "database/DatabaseManager.h"
 #include "models/PassiveComponent.h"
 #include "models/ActiveComponent.h"
+#include "utils/StartupReport.h"
+#include "utils/Trace.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -20,26 +26,306 @@
 #include <QApplication>
 #include <QGroupBox>
 #include <QIcon>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QInputDialog>
+#include <QProgressDialog>
+#include <QRegularExpression>
+#include <QEvent>
+#include <QTimer>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    /// Table view whose paints show up as trace spans
+    class TracedTableView : public QTableView
+    {
+    public:
+        using QTableView::QTableView;
+
+    protected:
+        void paintEvent(QPaintEvent *event) override
+        {
+            TRACE_SCOPE("ui", "QTableView::paintEvent");
+            QTableView::paintEvent(event);
+        }
+    };
+}
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), m_splitter(nullptr), m_sidebarList(nullptr), m_tableView(nullptr), m_searchEdit(nullptr), m_categoryFilter(nullptr), m_addButton(nullptr), m_editButton(nullptr), m_deleteButton(nullptr), m_refreshButton(nullptr), m_statusLabel(nullptr), m_model(nullptr), m_proxyModel(nullptr), m_showingLowStockOnly(false)
+    : QMainWindow(parent), m_splitter(nullptr), m_sidebarList(nullptr), m_tableView(nullptr), m_searchEdit(nullptr), m_categoryFilter(nullptr), m_addButton(nullptr), m_editButton(nullptr), m_deleteButton(nullptr), m_refreshButton(nullptr), m_statusLabel(nullptr), m_model(nullptr), m_proxyModel(nullptr), m_showingLowStockOnly(false), m_loaderThread(nullptr), m_loadGeneration(0), m_firstBatchPending(false), m_startupPending(true), m_reconciling(false), m_modelHoldsInventory(false), m_exportThread(nullptr)
 {
     setWindowTitle(Config.appName());
     setMinimumSize(Config.defaultWindowWidth(), Config.defaultWindowHeight());
 
+    // The database is opened once the empty window has painted, see eventFilter()
+    {
+        ScopedTimer timer("MainWindow::setupUi");
+        setupUi();
+        setupMenuBar();
+        setupToolBar();
+        setupConnections();
+    }
+
+    m_tableView->viewport()->installEventFilter(this);
+}
+
+MainWindow::~MainWindow()
+{
+    cancelExport();
+    cancelBackgroundLoad();
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_tableView->viewport() && event->type() == QEvent::Paint)
+    {
+        m_tableView->viewport()->removeEventFilter(this);
+        StartupReport::instance().mark("first paint");
+        QTimer::singleShot(0, this, &MainWindow::startInitialLoad);
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void MainWindow::startInitialLoad()
+{
+    TRACE_SCOPE("ui", "MainWindow::startInitialLoad");
+    ScopedTimer timer("MainWindow::startInitialLoad");
     initializeDatabase();
-    loadCategories();
-    setupUi();
-    setupMenuBar();
-    setupToolBar();
-    setupConnections();
+    {
+        ScopedTimer categoriesTimer("loadCategories");
+        loadCategories();
+        updateSidebarCategories();
+        updateCategoryFilter();
+    }
+    if (!showSnapshot())
+    {
+        startBackgroundLoad();
+    }
+}
 
-    refreshData();
+bool MainWindow::showSnapshot()
+{
+    TRACE_SCOPE("ui", "MainWindow::showSnapshot");
+    auto settings = Config.settings();
+    auto &db = DatabaseManager::instance();
+    if (!settings->snapshotEnabled || !db.isConnected() || !QFileInfo::exists(settings->snapshotPath))
+    {
+        return false;
+    }
+
+    InventorySnapshot snapshot;
+    QString error;
+    {
+        ScopedTimer timer("InventorySnapshot::open");
+        if (!snapshot.open(settings->snapshotPath, db.databasePath(), &error))
+        {
+            qWarning() << "Ignoring inventory snapshot:" << error;
+            return false;
+        }
+    }
+    {
+        ScopedTimer timer("InventorySnapshot::loadAll");
+        m_model->setComponents(snapshot.loadAll());
+    }
+    if (m_startupPending)
+    {
+        StartupReport::instance().mark("first rows");
+    }
+
+    const InventorySnapshot::Stamp stamp = InventorySnapshot::stampFor(db.databasePath());
+    if (stamp.isValid() && stamp == snapshot.stamp())
+    {
+        qDebug() << "Loaded" << m_model->componentCount() << "components from the snapshot";
+        m_snapshotStamp = stamp;
+        m_modelHoldsInventory = true;
+        reportStartupComplete();
+        updateStatusBar();
+        updateQuickStats();
+        return true;
+    }
+
+    // The database changed since the snapshot was written
+    startBackgroundLoad(true);
+    return true;
+}
+
+void MainWindow::startBackgroundLoad(bool reconcile)
+{
+    cancelBackgroundLoad();
+    m_modelHoldsInventory = false;
+    m_reconciling = reconcile;
+    if (!reconcile)
+    {
+        m_model->clear();
+    }
+
+    auto &db = DatabaseManager::instance();
+    if (!db.isConnected())
+    {
+        reportStartupComplete();
+        return;
+    }
+
+    // The first batch fills the visible part of the table
+    int rowHeight = std::max(1, m_tableView->verticalHeader()->defaultSectionSize());
+    int firstBatchSize = m_tableView->viewport()->height() / rowHeight + 1;
+
+    auto *loader = new ComponentLoader(db.databasePath(), db.categoryRegistry(), db.queryStats(), firstBatchSize);
+    m_loaderThread = new QThread(this);
+    m_loaderThread->setObjectName("ComponentLoader");
+    loader->moveToThread(m_loaderThread);
+
+    const int generation = ++m_loadGeneration;
+    m_firstBatchPending = true;
+
+    connect(m_loaderThread, &QThread::started, loader, &ComponentLoader::run);
+    connect(loader, &ComponentLoader::batchLoaded, this, [this, generation](ComponentBatch batch)
+            {
+                if (generation == m_loadGeneration)
+                {
+                    onComponentBatchLoaded(std::move(batch));
+                }
+            });
+    connect(loader, &ComponentLoader::finished, this, [this, generation](int componentCount)
+            {
+                if (generation == m_loadGeneration)
+                {
+                    onBackgroundLoadFinished(componentCount);
+                }
+            });
+    connect(loader, &ComponentLoader::failed, this, [this](const QString &message)
+            {
+                m_reconciling = false;
+                m_reconciledComponents.clear();
+                reportStartupComplete();
+                onDatabaseError(message);
+            });
+    connect(loader, &ComponentLoader::finished, m_loaderThread, &QThread::quit);
+    connect(loader, &ComponentLoader::failed, m_loaderThread, &QThread::quit);
+    connect(m_loaderThread, &QThread::finished, loader, &QObject::deleteLater);
+    connect(m_loaderThread, &QThread::finished, m_loaderThread, &QObject::deleteLater);
+
+    m_statusLabel->setText(Lang.translate(TrKey::SidebarLoading));
+    m_loaderThread->start();
+}
+
+void MainWindow::cancelBackgroundLoad()
+{
+    m_reconciling = false;
+    m_reconciledComponents.clear();
+    if (!m_loaderThread)
+    {
+        return;
+    }
+
+    ++m_loadGeneration;
+    m_loaderThread->requestInterruption();
+    m_loaderThread->quit();
+    m_loaderThread->wait();
+    m_loaderThread = nullptr;
+}
+
+void MainWindow::saveSnapshot()
+{
+    TRACE_SCOPE("ui", "MainWindow::saveSnapshot");
+    auto settings = Config.settings();
+    auto &db = DatabaseManager::instance();
+    if (!settings->snapshotEnabled || !db.isConnected())
+    {
+        return;
+    }
+
+    // Worker connections would keep the WAL from being checkpointed on close
+    cancelExport();
+    cancelBackgroundLoad();
+
+    const QString databasePath = db.databasePath();
+    if (m_snapshotStamp.isValid() && InventorySnapshot::stampFor(databasePath) == m_snapshotStamp)
+    {
+        // Nothing was written since the snapshot was loaded
+        db.close();
+        return;
+    }
+
+    std::vector<std::unique_ptr<Component>> fetched;
+    std::vector<const Component *> components;
+    if (m_modelHoldsInventory)
+    {
+        components.reserve(m_model->componentCount());
+        for (int row = 0; row < m_model->componentCount(); ++row)
+        {
+            components.push_back(m_model->getComponentAt(row));
+        }
+    }
+    else
+    {
+        fetched = db.fetchAllComponents();
+        components.reserve(fetched.size());
+        for (const auto &component : fetched)
+        {
+            components.push_back(component.get());
+        }
+    }
+
+    // Closing the last connection checkpoints the WAL, so the stamp matches what the next start sees
+    db.close();
+
+    QString error;
+    if (!InventorySnapshot::write(settings->snapshotPath, InventorySnapshot::stampFor(databasePath), components, &error))
+    {
+        qWarning() << "Failed to write inventory snapshot:" << error;
+    }
+}
+
+void MainWindow::onComponentBatchLoaded(ComponentBatch batch)
+{
+    TRACE_SCOPE("ui", "MainWindow::onComponentBatchLoaded");
+    if (m_reconciling)
+    {
+        std::move(batch->begin(), batch->end(), std::back_inserter(m_reconciledComponents));
+        return;
+    }
+    m_model->appendComponents(std::move(*batch));
+
+    if (m_firstBatchPending)
+    {
+        m_firstBatchPending = false;
+        if (m_startupPending)
+        {
+            StartupReport::instance().mark("first rows");
+        }
+    }
     updateStatusBar();
 }
 
-MainWindow::~MainWindow() = default;
+void MainWindow::reportStartupComplete()
+{
+    if (m_startupPending)
+    {
+        m_startupPending = false;
+        StartupReport::instance().mark("fully loaded");
+        StartupReport::instance().finish();
+    }
+}
+
+void MainWindow::onBackgroundLoadFinished(int componentCount)
+{
+    qDebug() << "Loaded" << componentCount << "components";
+    if (m_reconciling)
+    {
+        m_reconciling = false;
+        m_model->setComponents(std::move(m_reconciledComponents));
+        m_reconciledComponents.clear();
+    }
+    m_modelHoldsInventory = true;
+    reportStartupComplete();
+
+    updateStatusBar();
+    updateQuickStats();
+}
 
 void MainWindow::loadCategories()
 {
@@ -66,92 +352,101 @@ void MainWindow::setupUi()
 void MainWindow::setupMenuBar()
 {
     // File menu
-    qDebug() << Lang.translate("menu.file.title");
-    QMenu *fileMenu = menuBar()->addMenu(Lang.translate("menu.file.title"));
+    qDebug() << Lang.translate(TrKey::MenuFileTitle);
+    QMenu *fileMenu = menuBar()->addMenu(Lang.translate(TrKey::MenuFileTitle));
 
-    QAction *refreshAction = fileMenu->addAction(Lang.translate("menu.file.refresh"));
+    QAction *refreshAction = fileMenu->addAction(Lang.translate(TrKey::MenuFileRefresh));
     refreshAction->setShortcut(QKeySequence::Refresh);
     connect(refreshAction, &QAction::triggered, this, &MainWindow::refreshData);
 
+    QAction *importAction = fileMenu->addAction(Lang.translate(TrKey::MenuFileImportCsv));
+    connect(importAction, &QAction::triggered, this, &MainWindow::onImportCsv);
+
+    QAction *exportAction = fileMenu->addAction(Lang.translate(TrKey::MenuFileExport));
+    connect(exportAction, &QAction::triggered, this, &MainWindow::onExport);
+
     fileMenu->addSeparator();
 
-    QAction *exitAction = fileMenu->addAction(Lang.translate("menu.file.exit"));
+    QAction *exitAction = fileMenu->addAction(Lang.translate(TrKey::MenuFileExit));
     exitAction->setShortcut(QKeySequence::Quit);
     connect(exitAction, &QAction::triggered, this, &QWidget::close);
 
     // Component menu
-    QMenu *componentMenu = menuBar()->addMenu(Lang.translate("menu.component.title"));
+    QMenu *componentMenu = menuBar()->addMenu(Lang.translate(TrKey::MenuComponentTitle));
 
-    QAction *addAction = componentMenu->addAction(Lang.translate("menu.component.addNew"));
+    QAction *addAction = componentMenu->addAction(Lang.translate(TrKey::MenuComponentAddNew));
     addAction->setShortcut(QKeySequence::New);
     connect(addAction, &QAction::triggered, this, &MainWindow::onAddComponent);
 
-    QAction *editAction = componentMenu->addAction(Lang.translate("menu.component.edit"));
+    QAction *editAction = componentMenu->addAction(Lang.translate(TrKey::MenuComponentEdit));
     editAction->setShortcut(Qt::Key_F2);
     connect(editAction, &QAction::triggered, this, &MainWindow::onEditComponent);
 
-    QAction *deleteAction = componentMenu->addAction(Lang.translate("menu.component.delete"));
+    QAction *deleteAction = componentMenu->addAction(Lang.translate(TrKey::MenuComponentDelete));
     deleteAction->setShortcut(QKeySequence::Delete);
     connect(deleteAction, &QAction::triggered, this, &MainWindow::onDeleteComponent);
 
     // Category menu
-    QMenu *categoryMenu = menuBar()->addMenu(Lang.translate("menu.category.title"));
+    QMenu *categoryMenu = menuBar()->addMenu(Lang.translate(TrKey::MenuCategoryTitle));
 
-    QAction *addCategoryAction = categoryMenu->addAction(Lang.translate("menu.category.addNew"));
+    QAction *addCategoryAction = categoryMenu->addAction(Lang.translate(TrKey::MenuCategoryAddNew));
     connect(addCategoryAction, &QAction::triggered, this, &MainWindow::onAddCategory);
 
-    QAction *manageCategoriesAction = categoryMenu->addAction(Lang.translate("menu.category.manage"));
+    QAction *manageCategoriesAction = categoryMenu->addAction(Lang.translate(TrKey::MenuCategoryManage));
     connect(manageCategoriesAction, &QAction::triggered, this, &MainWindow::onManageCategories);
 
     // View menu
-    QMenu *viewMenu = menuBar()->addMenu(Lang.translate("menu.view.title"));
+    QMenu *viewMenu = menuBar()->addMenu(Lang.translate(TrKey::MenuViewTitle));
 
-    QAction *showAllAction = viewMenu->addAction(Lang.translate("menu.view.showAll"));
+    QAction *showAllAction = viewMenu->addAction(Lang.translate(TrKey::MenuViewShowAll));
     connect(showAllAction, &QAction::triggered, this, &MainWindow::onShowAll);
 
-    QAction *showLowStockAction = viewMenu->addAction(Lang.translate("menu.view.showLowStock"));
+    QAction *showLowStockAction = viewMenu->addAction(Lang.translate(TrKey::MenuViewShowLowStock));
     connect(showLowStockAction, &QAction::triggered, this, &MainWindow::onShowLowStock);
 
     // Help menu
-    QMenu *helpMenu = menuBar()->addMenu(Lang.translate("menu.help.title"));
+    QMenu *helpMenu = menuBar()->addMenu(Lang.translate(TrKey::MenuHelpTitle));
+
+    QAction *diagnosticsAction = helpMenu->addAction(Lang.translate(TrKey::MenuHelpDiagnostics));
+    connect(diagnosticsAction, &QAction::triggered, this, &MainWindow::onShowDiagnostics);
 
-    QAction *aboutQtAction = helpMenu->addAction(Lang.translate("menu.help.aboutQt"));
+    QAction *aboutQtAction = helpMenu->addAction(Lang.translate(TrKey::MenuHelpAboutQt));
     connect(aboutQtAction, &QAction::triggered, qApp, &QApplication::aboutQt);
 }
 
 void MainWindow::setupToolBar()
 {
-    QToolBar *toolBar = addToolBar(Lang.translate("toolbar.title"));
+    QToolBar *toolBar = addToolBar(Lang.translate(TrKey::ToolbarTitle));
     toolBar->setMovable(false);
 
-    m_addButton = new QPushButton(Lang.translate("toolbar.add"), this);
-    m_addButton->setToolTip(Lang.translate("toolbar.addTooltip"));
+    m_addButton = new QPushButton(Lang.translate(TrKey::ToolbarAdd), this);
+    m_addButton->setToolTip(Lang.translate(TrKey::ToolbarAddTooltip));
     toolBar->addWidget(m_addButton);
 
-    m_editButton = new QPushButton(Lang.translate("toolbar.edit"), this);
-    m_editButton->setToolTip(Lang.translate("toolbar.editTooltip"));
+    m_editButton = new QPushButton(Lang.translate(TrKey::ToolbarEdit), this);
+    m_editButton->setToolTip(Lang.translate(TrKey::ToolbarEditTooltip));
     m_editButton->setEnabled(false);
     toolBar->addWidget(m_editButton);
 
-    m_deleteButton = new QPushButton(Lang.translate("toolbar.delete"), this);
-    m_deleteButton->setToolTip(Lang.translate("toolbar.deleteTooltip"));
+    m_deleteButton = new QPushButton(Lang.translate(TrKey::ToolbarDelete), this);
+    m_deleteButton->setToolTip(Lang.translate(TrKey::ToolbarDeleteTooltip));
     m_deleteButton->setEnabled(false);
     toolBar->addWidget(m_deleteButton);
 
     toolBar->addSeparator();
 
-    m_refreshButton = new QPushButton(Lang.translate("toolbar.refresh"), this);
-    m_refreshButton->setToolTip(Lang.translate("toolbar.refreshTooltip"));
+    m_refreshButton = new QPushButton(Lang.translate(TrKey::ToolbarRefresh), this);
+    m_refreshButton->setToolTip(Lang.translate(TrKey::ToolbarRefreshTooltip));
     toolBar->addWidget(m_refreshButton);
 
     toolBar->addSeparator();
 
     // Search box
-    QLabel *searchLabel = new QLabel(" " + Lang.translate("toolbar.search") + " ", this);
+    QLabel *searchLabel = new QLabel(" " + Lang.translate(TrKey::ToolbarSearch) + " ", this);
     toolBar->addWidget(searchLabel);
 
     m_searchEdit = new QLineEdit(this);
-    m_searchEdit->setPlaceholderText(Lang.translate("toolbar.searchPlaceholder"));
+    m_searchEdit->setPlaceholderText(Lang.translate(TrKey::ToolbarSearchPlaceholder));
     m_searchEdit->setMinimumWidth(200);
     m_searchEdit->setClearButtonEnabled(true);
     toolBar->addWidget(m_searchEdit);
@@ -159,7 +454,7 @@ void MainWindow::setupToolBar()
     toolBar->addSeparator();
 
     // Category filter
-    QLabel *filterLabel = new QLabel(" " + Lang.translate("toolbar.category") + " ", this);
+    QLabel *filterLabel = new QLabel(" " + Lang.translate(TrKey::ToolbarCategory) + " ", this);
     toolBar->addWidget(filterLabel);
 
     m_categoryFilter = new QComboBox(this);
@@ -175,13 +470,13 @@ QWidget *MainWindow::createSidebar()
     layout->setContentsMargins(5, 5, 5, 5);
 
     // Title
-    QLabel *title = new QLabel(QString("<b>%1</b>").arg(Lang.translate("sidebar.title")), sidebar);
+    QLabel *title = new QLabel(QString("<b>%1</b>").arg(Lang.translate(TrKey::SidebarTitle)), sidebar);
     layout->addWidget(title);
 
     // Category list
     m_sidebarList = new QListWidget(sidebar);
-    m_sidebarList->addItem(Lang.translate("sidebar.allComponents"));
-    m_sidebarList->addItem(Lang.translate("sidebar.lowStockItems"));
+    m_sidebarList->addItem(Lang.translate(TrKey::SidebarAllComponents));
+    m_sidebarList->addItem(Lang.translate(TrKey::SidebarLowStockItems));
     m_sidebarList->addItem(QString::fromUtf8("───────────────"));
     m_sidebarList->item(2)->setFlags(Qt::NoItemFlags); // Separator not selectable
 
@@ -192,10 +487,10 @@ QWidget *MainWindow::createSidebar()
     layout->addWidget(m_sidebarList);
 
     // Stats group
-    QGroupBox *statsGroup = new QGroupBox(Lang.translate("sidebar.quickStats"), sidebar);
+    QGroupBox *statsGroup = new QGroupBox(Lang.translate(TrKey::SidebarQuickStats), sidebar);
     QVBoxLayout *statsLayout = new QVBoxLayout(statsGroup);
 
-    QLabel *statsPlaceholder = new QLabel(Lang.translate("sidebar.loading"), statsGroup);
+    QLabel *statsPlaceholder = new QLabel(Lang.translate(TrKey::SidebarLoading), statsGroup);
     statsPlaceholder->setObjectName("statsLabel");
     statsLayout->addWidget(statsPlaceholder);
 
@@ -211,7 +506,7 @@ QWidget *MainWindow::createMainContent()
     layout->setContentsMargins(5, 5, 5, 5);
 
     // Table view
-    m_tableView = new QTableView(content);
+    m_tableView = new TracedTableView(content);
 
     // Create model and proxy
     m_model = new ComponentTableModel(this);
@@ -229,6 +524,13 @@ QWidget *MainWindow::createMainContent()
     m_tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_tableView->verticalHeader()->setVisible(false);
     m_tableView->setShowGrid(true);
+    m_tableView->setWordWrap(false);
+
+    // Paint from the model's row cache with uniform row heights
+    InventoryItemDelegate *delegate = new InventoryItemDelegate(m_model, m_tableView);
+    m_tableView->setItemDelegate(delegate);
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->verticalHeader()->setDefaultSectionSize(delegate->rowHeight());
 
     // Set initial column widths
     m_tableView->setColumnWidth(ComponentTableModel::ColId, 50);
@@ -268,10 +570,21 @@ void MainWindow::setupConnections()
     // Database manager
     connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
             this, &MainWindow::updateStatusBar);
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged, this, [this]()
+            {
+                // A load that started before the change would deliver rows the edit
+                // never reached, or bring back deleted ones
+                if (m_loaderThread && m_loaderThread->isRunning() && !m_modelHoldsInventory)
+                {
+                    startBackgroundLoad(m_reconciling);
+                }
+            });
     connect(&DatabaseManager::instance(), &DatabaseManager::errorOccurred,
             this, &MainWindow::onDatabaseError);
     connect(&DatabaseManager::instance(), &DatabaseManager::categoriesChanged,
             this, &MainWindow::onCategoriesChanged);
+    connect(&AppConfig::instance(), &AppConfig::configChanged,
+            this, &MainWindow::onConfigChanged);
 }
 
 void MainWindow::initializeDatabase()
@@ -279,51 +592,68 @@ void MainWindow::initializeDatabase()
     AppConfig &config = AppConfig::instance();
     auto &db = DatabaseManager::instance();
 
-    if (!db.initialize(config.databasePath()))
+    bool initialized;
+    {
+        ScopedTimer timer("DatabaseManager::initialize");
+        initialized = db.initialize(config.databasePath());
+    }
+    if (!initialized)
     {
-        QMessageBox::critical(this, Lang.translate("messages.databaseError"),
-                              Lang.translate("messages.databaseInitFailed", db.lastError().text(), "Failed to initialize database:\n%1"));
+        QMessageBox::critical(this, Lang.translate(TrKey::MessagesDatabaseError),
+                              Lang.translate(TrKey::MessagesDatabaseInitFailed, db.lastError().text(), "Failed to initialize database:\n%1"));
         return;
     }
 
     // Populate sample data on first run (if enabled in config)
     if (config.enableSampleData())
     {
+        ScopedTimer timer("DatabaseManager::populateSampleData");
         db.populateSampleData();
     }
 }
 
 void MainWindow::refreshData()
 {
+    TRACE_SCOPE("ui", "MainWindow::refreshData");
+    cancelBackgroundLoad();
     m_model->refresh();
+    m_modelHoldsInventory = true;
     updateStatusBar();
+    updateQuickStats();
 
-    // Update sidebar stats
+    // A refresh during the initial streaming load completes startup instead
+    reportStartupComplete();
+}
+
+void MainWindow::updateQuickStats()
+{
+    TRACE_SCOPE("ui", "MainWindow::updateQuickStats");
     QLabel *statsLabel = m_splitter->findChild<QLabel *>("statsLabel");
     if (statsLabel)
     {
         int total = m_model->componentCount();
-        auto lowStock = DatabaseManager::instance().fetchLowStock();
-        statsLabel->setText(Lang.translate("sidebar.totalLabel", QString::number(total), "Total: %1") + "\n" +
-                            Lang.translate("sidebar.lowStockLabel", QString::number(lowStock.size()), "Low Stock: %1"));
+        int lowStock = DatabaseManager::instance().countLowStock();
+        statsLabel->setText(Lang.translate(TrKey::SidebarTotalLabel, QString::number(total), "Total: %1") + "\n" +
+                            Lang.translate(TrKey::SidebarLowStockLabel, QString::number(lowStock), "Low Stock: %1"));
     }
 }
 
 void MainWindow::onSearchTextChanged(const QString &text)
 {
-    m_proxyModel->setFilterRegularExpression(
-        QRegularExpression(text, QRegularExpression::CaseInsensitiveOption));
+    TRACE_SCOPE("ui", "MainWindow::onSearchTextChanged");
+    m_proxyModel->setFilterRegularExpression(ComponentTableModel::searchExpression(text));
     updateStatusBar();
 }
 
 void MainWindow::onCategoryFilterChanged(int index)
 {
+    TRACE_SCOPE("ui", "MainWindow::onCategoryFilterChanged");
     QString category = m_categoryFilter->itemData(index).toString();
 
     if (category.isEmpty())
     {
         m_proxyModel->setFilterKeyColumn(-1);
-        m_proxyModel->setFilterRegularExpression(m_searchEdit->text());
+        m_proxyModel->setFilterRegularExpression(ComponentTableModel::searchExpression(m_searchEdit->text()));
     }
     else
     {
@@ -339,7 +669,7 @@ void MainWindow::onCategoryFilterChanged(int index)
 void MainWindow::onAddComponent()
 {
     ComponentDialog dialog(this);
-    dialog.setWindowTitle(Lang.translate("dialog.component.titleAdd"));
+    dialog.setWindowTitle(Lang.translate(TrKey::DialogComponentTitleAdd));
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -362,8 +692,8 @@ void MainWindow::onEditComponent()
     int id = getSelectedComponentId();
     if (id < 0)
     {
-        QMessageBox::information(this, Lang.translate("messages.noSelection"),
-                                 Lang.translate("messages.selectComponentToEdit"));
+        QMessageBox::information(this, Lang.translate(TrKey::MessagesNoSelection),
+                                 Lang.translate(TrKey::MessagesSelectComponentToEdit));
         return;
     }
 
@@ -372,7 +702,7 @@ void MainWindow::onEditComponent()
         return;
 
     ComponentDialog dialog(this);
-    dialog.setWindowTitle(Lang.translate("dialog.component.titleEdit"));
+    dialog.setWindowTitle(Lang.translate(TrKey::DialogComponentTitleEdit));
     dialog.setComponent(component);
 
     if (dialog.exec() == QDialog::Accepted)
@@ -395,8 +725,8 @@ void MainWindow::onDeleteComponent()
     int id = getSelectedComponentId();
     if (id < 0)
     {
-        QMessageBox::information(this, Lang.translate("messages.noSelection"),
-                                 Lang.translate("messages.selectComponentToDelete"));
+        QMessageBox::information(this, Lang.translate(TrKey::MessagesNoSelection),
+                                 Lang.translate(TrKey::MessagesSelectComponentToDelete));
         return;
     }
 
@@ -405,8 +735,8 @@ void MainWindow::onDeleteComponent()
         return;
 
     QMessageBox::StandardButton reply = QMessageBox::question(this,
-                                                              Lang.translate("dialog.category.confirmDelete"),
-                                                              Lang.translate("messages.confirmDeleteComponent", component->getName(), "Are you sure you want to delete '%1'?"),
+                                                              Lang.translate(TrKey::DialogCategoryConfirmDelete),
+                                                              Lang.translate(TrKey::MessagesConfirmDeleteComponent, component->getName(), "Are you sure you want to delete '%1'?"),
                                                               QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes)
@@ -436,14 +766,40 @@ void MainWindow::onTableDoubleClicked(const QModelIndex &index)
 
 void MainWindow::onShowLowStock()
 {
+    TRACE_SCOPE("ui", "MainWindow::onShowLowStock");
     m_showingLowStockOnly = true;
+    cancelBackgroundLoad();
+    m_modelHoldsInventory = false;
     m_model->setComponents(DatabaseManager::instance().fetchLowStock());
     m_sidebarList->setCurrentRow(1); // Low Stock Items
     updateStatusBar();
 }
 
+void MainWindow::onConfigChanged(AppConfig::ChangedFields fields)
+{
+    if (fields & AppConfig::AppInfoChanged)
+    {
+        setWindowTitle(Config.appName());
+    }
+
+    if (fields & AppConfig::LowStockThresholdChanged)
+    {
+        // The model re-flags its rows itself; the low stock list and counts need a new query
+        if (m_showingLowStockOnly)
+        {
+            onShowLowStock();
+        }
+        else
+        {
+            updateStatusBar();
+        }
+        updateQuickStats();
+    }
+}
+
 void MainWindow::onShowAll()
 {
+    TRACE_SCOPE("ui", "MainWindow::onShowAll");
     m_showingLowStockOnly = false;
     m_categoryFilter->setCurrentIndex(0);
     m_searchEdit->clear();
@@ -453,6 +809,7 @@ void MainWindow::onShowAll()
 
 void MainWindow::onSidebarCategorySelected(QListWidgetItem *item)
 {
+    TRACE_SCOPE("ui", "MainWindow::onSidebarCategorySelected");
     if (!item || !(item->flags() & Qt::ItemIsSelectable))
         return;
 
@@ -487,21 +844,22 @@ void MainWindow::onSidebarCategorySelected(QListWidgetItem *item)
 
 void MainWindow::updateStatusBar()
 {
+    TRACE_SCOPE("ui", "MainWindow::updateStatusBar");
     int total = m_model->componentCount();
     int visible = m_proxyModel->rowCount();
 
     QString status;
     if (m_showingLowStockOnly)
     {
-        status = Lang.translate("statusBar.showingLowStock", QString::number(visible), "Showing %1 low stock items");
+        status = Lang.translate(TrKey::StatusBarShowingLowStock, QString::number(visible), "Showing %1 low stock items");
     }
     else if (visible != total)
     {
-        status = Lang.translate("statusBar.showingFiltered", QStringList{QString::number(visible), QString::number(total)}, "Showing %1 of %2 components");
+        status = Lang.translate(TrKey::StatusBarShowingFiltered, QStringList{QString::number(visible), QString::number(total)}, "Showing %1 of %2 components");
     }
     else
     {
-        status = Lang.translate("statusBar.totalComponents", QString::number(total), "Total: %1 components");
+        status = Lang.translate(TrKey::StatusBarTotalComponents, QString::number(total), "Total: %1 components");
     }
 
     m_statusLabel->setText(status);
@@ -509,7 +867,7 @@ void MainWindow::updateStatusBar()
 
 void MainWindow::onDatabaseError(const QString &message)
 {
-    QMessageBox::warning(this, Lang.translate("messages.databaseError"), message);
+    QMessageBox::warning(this, Lang.translate(TrKey::MessagesDatabaseError), message);
 }
 
 int MainWindow::getSelectedComponentId() const
@@ -548,7 +906,7 @@ void MainWindow::updateCategoryFilter()
     QString currentCategory = m_categoryFilter->currentData().toString();
 
     m_categoryFilter->clear();
-    m_categoryFilter->addItem(Lang.translate("toolbar.allCategories"), "");
+    m_categoryFilter->addItem(Lang.translate(TrKey::ToolbarAllCategories), "");
 
     for (const auto &cat : m_categories)
     {
@@ -565,6 +923,7 @@ void MainWindow::updateCategoryFilter()
 
 void MainWindow::onCategoriesChanged()
 {
+    TRACE_SCOPE("ui", "MainWindow::onCategoriesChanged");
     loadCategories();
     updateSidebarCategories();
     updateCategoryFilter();
@@ -574,7 +933,7 @@ void MainWindow::onCategoriesChanged()
 void MainWindow::onAddCategory()
 {
     CategoryDialog dialog(this);
-    dialog.setWindowTitle(Lang.translate("dialog.category.titleAdd"));
+    dialog.setWindowTitle(Lang.translate(TrKey::DialogCategoryTitleAdd));
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -587,16 +946,181 @@ void MainWindow::onAddCategory()
         }
         else
         {
-            QMessageBox::warning(this, Lang.translate("messages.error"), Lang.translate("messages.addCategoryFailed"));
+            QMessageBox::warning(this, Lang.translate(TrKey::MessagesError), Lang.translate(TrKey::MessagesAddCategoryFailed));
         }
     }
 }
 
+void MainWindow::onShowDiagnostics()
+{
+    DiagnosticsDialog dialog(DatabaseManager::instance().queryStats(), this);
+    dialog.exec();
+}
+
+void MainWindow::onImportCsv()
+{
+    QString path = QFileDialog::getOpenFileName(this, Lang.translate(TrKey::DialogImportTitle), QString(),
+                                                Lang.translate(TrKey::DialogImportFileFilter));
+    if (path.isEmpty())
+    {
+        return;
+    }
+
+    // Parsing runs on the thread pool; the dialog keeps events flowing between inserted chunks
+    QProgressDialog progress(Lang.translate(TrKey::DialogImportProgress), Lang.translate(TrKey::DialogImportCancel),
+                             0, 1000, this);
+    progress.setWindowTitle(Lang.translate(TrKey::DialogImportTitle));
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
+    CsvImporter importer(DatabaseManager::instance());
+    connect(&importer, &CsvImporter::progress, &progress, [&](qint64 done, qint64 total)
+            {
+                progress.setValue(total > 0 ? static_cast<int>(done * 1000 / total) : 0);
+                if (progress.wasCanceled())
+                {
+                    importer.cancel();
+                } });
+
+    // refreshData() below reloads once; a load still running would be restarted by the
+    // commit's dataChanged and then thrown away again
+    const bool wasLoading = m_loaderThread && !m_modelHoldsInventory;
+    const bool wasReconciling = m_reconciling;
+    cancelBackgroundLoad();
+    CsvImporter::Result result = importer.importFile(path);
+    progress.reset();
+
+    if (!result.ok)
+    {
+        if (wasLoading)
+        {
+            startBackgroundLoad(wasReconciling);
+        }
+        if (!result.cancelled)
+        {
+            QMessageBox::warning(this, Lang.translate(TrKey::MessagesError),
+                                 Lang.translate(TrKey::DialogImportFailed, result.error, "Import failed:\n%1"));
+        }
+        return;
+    }
+
+    refreshData();
+
+    QString summary = Lang.translate(TrKey::DialogImportSummary,
+                                     QStringList{QString::number(result.imported), QString::number(result.rows),
+                                                 QString::number(result.errorCount)},
+                                     "Imported %1 of %2 rows, %3 skipped.");
+    // The full list is in the return value; a dialog only has room for the first few
+    const int shownErrors = std::min<int>(static_cast<int>(result.errors.size()), 20);
+    for (int i = 0; i < shownErrors; ++i)
+    {
+        summary += "\n" + Lang.translate(TrKey::DialogImportRowError,
+                                         QStringList{QString::number(result.errors[i].line), result.errors[i].message},
+                                         "Line %1: %2");
+    }
+    QMessageBox::information(this, Lang.translate(TrKey::DialogImportTitle), summary);
+}
+
+void MainWindow::onExport()
+{
+    auto &db = DatabaseManager::instance();
+    if (m_exportThread || !db.isConnected())
+    {
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, Lang.translate(TrKey::DialogExportTitle), QString(),
+                                                Lang.translate(TrKey::DialogExportFileFilter));
+    if (path.isEmpty())
+    {
+        return;
+    }
+
+    // The search box matches every column, which SQL can't reproduce; category and low stock views can be
+    ComponentFilter filter;
+    if (!m_currentCategoryFilter.isEmpty() || m_showingLowStockOnly)
+    {
+        QMessageBox::StandardButton reply = QMessageBox::question(this, Lang.translate(TrKey::DialogExportTitle),
+                                                                  Lang.translate(TrKey::DialogExportCurrentViewOnly));
+        if (reply == QMessageBox::Yes)
+        {
+            filter.category = m_currentCategoryFilter;
+            filter.lowStockOnly = m_showingLowStockOnly;
+        }
+    }
+
+    auto *exporter = new ComponentExporter(db.databasePath(), db.categoryRegistry(), db.queryStats(), filter,
+                                           Config.settings()->lowStockThreshold, path,
+                                           ComponentExporter::formatForPath(path));
+    m_exportThread = new QThread(this);
+    m_exportThread->setObjectName("ComponentExporter");
+    exporter->moveToThread(m_exportThread);
+
+    auto *progress = new QProgressDialog(Lang.translate(TrKey::DialogExportProgress),
+                                         Lang.translate(TrKey::DialogExportCancel), 0, 1000, this);
+    progress->setWindowTitle(Lang.translate(TrKey::DialogExportTitle));
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    progress->setAutoReset(false);
+    progress->setMinimumDuration(500);
+
+    QPointer<QThread> thread = m_exportThread;
+    connect(progress, &QProgressDialog::canceled, this, [thread]()
+            {
+                if (thread)
+                {
+                    thread->requestInterruption();
+                } });
+    connect(exporter, &ComponentExporter::progress, progress, [progress](qint64 written, qint64 total)
+            { progress->setValue(total > 0 ? static_cast<int>(written * 1000 / total) : 0); });
+    // The dialog deletes itself when closed, so the results may arrive after it is gone
+    QPointer<QProgressDialog> dialog = progress;
+    connect(exporter, &ComponentExporter::finished, this, [this, dialog, path](qint64 written)
+            {
+                if (dialog)
+                {
+                    dialog->close();
+                }
+                statusBar()->showMessage(Lang.translate(TrKey::DialogExportDone,
+                                                        QStringList{QString::number(written), QDir::toNativeSeparators(path)},
+                                                        "Exported %1 components to %2"),
+                                         5000); });
+    connect(exporter, &ComponentExporter::cancelled, progress, &QWidget::close);
+    connect(exporter, &ComponentExporter::failed, this, [this, dialog](const QString &message)
+            {
+                if (dialog)
+                {
+                    dialog->close();
+                }
+                QMessageBox::warning(this, Lang.translate(TrKey::MessagesError), message); });
+
+    connect(m_exportThread, &QThread::started, exporter, &ComponentExporter::run);
+    connect(exporter, &ComponentExporter::finished, m_exportThread, &QThread::quit);
+    connect(exporter, &ComponentExporter::cancelled, m_exportThread, &QThread::quit);
+    connect(exporter, &ComponentExporter::failed, m_exportThread, &QThread::quit);
+    connect(m_exportThread, &QThread::finished, exporter, &QObject::deleteLater);
+    connect(m_exportThread, &QThread::finished, m_exportThread, &QObject::deleteLater);
+
+    m_exportThread->start();
+}
+
+void MainWindow::cancelExport()
+{
+    if (!m_exportThread)
+    {
+        return;
+    }
+
+    m_exportThread->requestInterruption();
+    m_exportThread->quit();
+    m_exportThread->wait();
+    m_exportThread = nullptr;
+}
+
 void MainWindow::onManageCategories()
 {
     // Show a dialog to manage (edit/delete) categories
     QDialog manageDialog(this);
-    manageDialog.setWindowTitle(Lang.translate("dialog.category.titleManage"));
+    manageDialog.setWindowTitle(Lang.translate(TrKey::DialogCategoryTitleManage));
     manageDialog.setMinimumSize(400, 300);
 
     QVBoxLayout *layout = new QVBoxLayout(&manageDialog);
@@ -611,9 +1135,9 @@ void MainWindow::onManageCategories()
 
     QHBoxLayout *buttonLayout = new QHBoxLayout();
 
-    QPushButton *editBtn = new QPushButton(Lang.translate("dialog.category.edit"), &manageDialog);
-    QPushButton *deleteBtn = new QPushButton(Lang.translate("dialog.category.delete"), &manageDialog);
-    QPushButton *closeBtn = new QPushButton(Lang.translate("dialog.category.close"), &manageDialog);
+    QPushButton *editBtn = new QPushButton(Lang.translate(TrKey::DialogCategoryEdit), &manageDialog);
+    QPushButton *deleteBtn = new QPushButton(Lang.translate(TrKey::DialogCategoryDelete), &manageDialog);
+    QPushButton *closeBtn = new QPushButton(Lang.translate(TrKey::DialogCategoryClose), &manageDialog);
 
     buttonLayout->addWidget(editBtn);
     buttonLayout->addWidget(deleteBtn);
@@ -628,8 +1152,8 @@ void MainWindow::onManageCategories()
         QListWidgetItem *currentItem = catList->currentItem();
         if (!currentItem)
         {
-            QMessageBox::information(&manageDialog, Lang.translate("dialog.category.noSelection"), 
-                                     Lang.translate("dialog.category.selectToEdit"));
+            QMessageBox::information(&manageDialog, Lang.translate(TrKey::DialogCategoryNoSelection), 
+                                     Lang.translate(TrKey::DialogCategorySelectToEdit));
             return;
         }
 
@@ -651,7 +1175,7 @@ void MainWindow::onManageCategories()
         if (!found) return;
 
         CategoryDialog editDialog(this);
-        editDialog.setWindowTitle(Lang.translate("dialog.category.titleEdit"));
+        editDialog.setWindowTitle(Lang.translate(TrKey::DialogCategoryTitleEdit));
         editDialog.setCategory(catToEdit);
 
         if (editDialog.exec() == QDialog::Accepted)
@@ -666,7 +1190,7 @@ void MainWindow::onManageCategories()
             }
             else
             {
-                QMessageBox::warning(&manageDialog, Lang.translate("messages.error"), Lang.translate("messages.updateCategoryFailed"));
+                QMessageBox::warning(&manageDialog, Lang.translate(TrKey::MessagesError), Lang.translate(TrKey::MessagesUpdateCategoryFailed));
             }
         } });
 
@@ -675,8 +1199,8 @@ void MainWindow::onManageCategories()
         QListWidgetItem *currentItem = catList->currentItem();
         if (!currentItem)
         {
-            QMessageBox::information(&manageDialog, Lang.translate("dialog.category.noSelection"),
-                                     Lang.translate("dialog.category.selectToDelete"));
+            QMessageBox::information(&manageDialog, Lang.translate(TrKey::DialogCategoryNoSelection),
+                                     Lang.translate(TrKey::DialogCategorySelectToDelete));
             return;
         }
 
@@ -688,8 +1212,8 @@ void MainWindow::onManageCategories()
         {
             if (cat.id() == catId && cat.name() == "Other")
             {
-                QMessageBox::warning(&manageDialog, Lang.translate("dialog.category.cannotDelete"),
-                    Lang.translate("dialog.category.cannotDeleteOther"));
+                QMessageBox::warning(&manageDialog, Lang.translate(TrKey::DialogCategoryCannotDelete),
+                    Lang.translate(TrKey::DialogCategoryCannotDeleteOther));
                 return;
             }
         }
@@ -700,18 +1224,18 @@ void MainWindow::onManageCategories()
         QString message;
         if (componentCount > 0)
         {
-            message = Lang.translate("dialog.category.deleteWithComponents", 
+            message = Lang.translate(TrKey::DialogCategoryDeleteWithComponents, 
                              QStringList{catName, QString::number(componentCount)},
                              "Are you sure you want to delete category '%1'?\n\n%2 component(s) will be reassigned to 'Other'.");
         }
         else
         {
-            message = Lang.translate("dialog.category.deleteEmpty", catName,
+            message = Lang.translate(TrKey::DialogCategoryDeleteEmpty, catName,
                              "Are you sure you want to delete category '%1'?");
         }
 
         QMessageBox::StandardButton reply = QMessageBox::question(
-            &manageDialog, Lang.translate("dialog.category.confirmDelete"), message,
+            &manageDialog, Lang.translate(TrKey::DialogCategoryConfirmDelete), message,
             QMessageBox::Yes | QMessageBox::No);
 
         if (reply == QMessageBox::Yes)
@@ -722,7 +1246,7 @@ void MainWindow::onManageCategories()
             }
             else
             {
-                QMessageBox::warning(&manageDialog, Lang.translate("messages.error"), Lang.translate("messages.deleteCategoryFailed"));
+                QMessageBox::warning(&manageDialog, Lang.translate(TrKey::MessagesError), Lang.translate(TrKey::MessagesDeleteCategoryFailed));
             }
         } });
 
@@ -10,9 +10,15 @@
 #include <QSortFilterProxyModel>
 #include <QSplitter>
 #include <QListWidget>
+#include <QRegularExpression>
+#include <QPointer>
+#include <QThread>
 #include <memory>
 #include <vector>
 #include "models/CategoryInfo.h"
+#include "config/AppConfig.h"
+#include "database/ComponentLoader.h"
+#include "database/InventorySnapshot.h"
 
 class ComponentTableModel;
 
@@ -24,6 +30,12 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow() override;
 
+    /// Close the database and write the inventory snapshot for the next start; call once the event loop has ended
+    void saveSnapshot();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void refreshData();
 
@@ -49,6 +61,15 @@ private slots:
     void onAddCategory();
     void onCategoriesChanged();
 
+    void onConfigChanged(AppConfig::ChangedFields fields);
+    void onShowDiagnostics();
+    void onImportCsv();
+    void onExport();
+
+    void startInitialLoad();
+    void onComponentBatchLoaded(ComponentBatch batch);
+    void onBackgroundLoadFinished(int componentCount);
+
 private:
     void setupUi();
     void setupMenuBar();
@@ -65,6 +86,21 @@ private:
     void loadCategories();
     void updateSidebarCategories();
     void updateCategoryFilter();
+    void updateQuickStats();
+
+    /**
+     * Stream the whole inventory into the model from a worker thread. With
+     * @p reconcile the current rows stay visible and are replaced all at
+     * once when the load completes.
+     */
+    void startBackgroundLoad(bool reconcile = false);
+    /// Show the rows from the inventory snapshot; false if there is none to show
+    bool showSnapshot();
+    void cancelBackgroundLoad();
+    void reportStartupComplete();
+
+    /// Stop a running export and wait for its thread; the target file is left untouched
+    void cancelExport();
 
     // UI Components
     QSplitter *m_splitter;
@@ -88,6 +124,19 @@ private:
     // Current filter state
     QString m_currentCategoryFilter;
     bool m_showingLowStockOnly;
+
+    // Background inventory load
+    QPointer<QThread> m_loaderThread;
+    int m_loadGeneration; // Batches from a cancelled load carry an older generation
+    bool m_firstBatchPending;
+    bool m_startupPending; // Until the first full load reports to StartupReport
+    bool m_reconciling;    // The model shows snapshot rows until the running load replaces them
+    std::vector<std::unique_ptr<Component>> m_reconciledComponents;
+    bool m_modelHoldsInventory; // Every row of the table is in the model, not a filtered subset
+    InventorySnapshot::Stamp m_snapshotStamp; // Database state the shown snapshot was taken from
+
+    // Export running in the background, if any
+    QPointer<QThread> m_exportThread;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,280 @@
+#include "utils/AllocCounter.h"
+
+#include <QDebug>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Plain thread_local PODs: touching them must never allocate
+    thread_local quint64 t_allocations = 0;
+    thread_local quint64 t_deallocations = 0;
+    thread_local quint64 t_bytes = 0;
+
+    std::atomic<quint64> g_allocations{0};
+    std::atomic<quint64> g_deallocations{0};
+    std::atomic<quint64> g_bytes{0};
+
+    // Set while a budget warning is being logged so its own allocations don't count against anything
+    thread_local bool t_reporting = false;
+
+    [[maybe_unused]] inline void countAllocation(std::size_t size)
+    {
+        ++t_allocations;
+        t_bytes += size;
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    [[maybe_unused]] inline void countDeallocation()
+    {
+        ++t_deallocations;
+        g_deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool AllocCounter::isAvailable()
+{
+#ifdef ECIM_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocCounter::Counts AllocCounter::threadCounts()
+{
+    Counts counts;
+    counts.allocations = t_allocations;
+    counts.deallocations = t_deallocations;
+    counts.bytes = t_bytes;
+    return counts;
+}
+
+AllocCounter::Counts AllocCounter::processCounts()
+{
+    Counts counts;
+    counts.allocations = g_allocations.load(std::memory_order_relaxed);
+    counts.deallocations = g_deallocations.load(std::memory_order_relaxed);
+    counts.bytes = g_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+AllocCounter::Counts AllocScope::delta() const
+{
+    AllocCounter::Counts now = AllocCounter::threadCounts();
+    AllocCounter::Counts counts;
+    counts.allocations = now.allocations - m_start.allocations;
+    counts.deallocations = now.deallocations - m_start.deallocations;
+    counts.bytes = now.bytes - m_start.bytes;
+    return counts;
+}
+
+AllocBudget::~AllocBudget()
+{
+    quint64 allocations = m_scope.allocations();
+    if (allocations > m_maxAllocations && !t_reporting)
+    {
+        t_reporting = true;
+        qWarning() << "Allocation budget exceeded in" << m_operation << ":" << allocations
+                   << "allocations, budget" << m_maxAllocations;
+        t_reporting = false;
+    }
+}
+
+#ifdef ECIM_COUNT_ALLOCATIONS
+
+#if defined(__GLIBC__)
+// Interposing the C allocator catches Qt's containers, which bypass operator new
+extern "C"
+{
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *pointer, std::size_t size);
+    void __libc_free(void *pointer);
+
+    void *malloc(std::size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(std::size_t count, std::size_t size)
+    {
+        countAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *pointer, std::size_t size)
+    {
+        // A realloc is a new allocation as far as the hot path is concerned
+        countAllocation(size);
+        if (pointer)
+        {
+            countDeallocation();
+        }
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void *pointer)
+    {
+        if (pointer)
+        {
+            countDeallocation();
+        }
+        __libc_free(pointer);
+    }
+}
+
+namespace
+{
+    // operator new goes through the counted malloc above, so it must not count again
+    inline void *allocate(std::size_t size) { return __libc_malloc(size ? size : 1); }
+    inline void release(void *pointer) { __libc_free(pointer); }
+
+    // aligned_alloc is not interposed, and glibc's free() accepts its blocks
+    inline void *allocateAligned(std::size_t size, std::size_t alignment)
+    {
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    inline void releaseAligned(void *pointer) { __libc_free(pointer); }
+}
+#elif defined(_MSC_VER)
+#include <malloc.h>
+namespace
+{
+    inline void *allocate(std::size_t size) { return std::malloc(size ? size : 1); }
+    inline void release(void *pointer) { std::free(pointer); }
+    inline void *allocateAligned(std::size_t size, std::size_t alignment) { return _aligned_malloc(size ? size : 1, alignment); }
+    inline void releaseAligned(void *pointer) { _aligned_free(pointer); }
+}
+#else
+namespace
+{
+    inline void *allocate(std::size_t size) { return std::malloc(size ? size : 1); }
+    inline void release(void *pointer) { std::free(pointer); }
+    inline void *allocateAligned(std::size_t size, std::size_t alignment)
+    {
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    inline void releaseAligned(void *pointer) { std::free(pointer); }
+}
+#endif
+
+void *operator new(std::size_t size)
+{
+    countAllocation(size);
+    if (void *pointer = allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    countAllocation(size);
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    countAllocation(size);
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    if (pointer)
+    {
+        countDeallocation();
+    }
+    release(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+// Over-aligned types are rare here, but the default aligned operators free through the
+// interposed free() above, which would count a release without its allocation
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    countAllocation(size);
+    if (void *pointer = allocateAligned(size ? size : 1, static_cast<std::size_t>(alignment)))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    countAllocation(size);
+    return allocateAligned(size ? size : 1, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    countAllocation(size);
+    return allocateAligned(size ? size : 1, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    if (pointer)
+    {
+        countDeallocation();
+    }
+    releaseAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete(void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+#endif // ECIM_COUNT_ALLOCATIONS
@@ -0,0 +1,87 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Opt-in heap allocation counting
+ *
+ * Configure with -DECIM_COUNT_ALLOCATIONS=ON to replace the global
+ * operator new/delete (and, on glibc, malloc/calloc/realloc/free, which
+ * Qt's containers use) with versions that count per thread. Without the
+ * option every count stays zero and isAvailable() returns false.
+ *
+ * @code
+ * AllocScope scope;
+ * model.data(index);
+ * if (scope.allocations() != 0) ...
+ * @endcode
+ */
+class AllocCounter
+{
+public:
+    struct Counts
+    {
+        quint64 allocations = 0;
+        quint64 deallocations = 0;
+        quint64 bytes = 0; ///< Requested bytes, not counting allocator overhead
+    };
+
+    AllocCounter() = delete;
+
+    static bool isAvailable();
+
+    /// Running totals for the calling thread
+    static Counts threadCounts();
+
+    /// Running totals for the whole process
+    static Counts processCounts();
+};
+
+/**
+ * @brief Allocations made by the calling thread since construction
+ */
+class AllocScope
+{
+public:
+    AllocScope() : m_start(AllocCounter::threadCounts()) {}
+
+    AllocCounter::Counts delta() const;
+    quint64 allocations() const { return delta().allocations; }
+
+private:
+    AllocCounter::Counts m_start;
+};
+
+/**
+ * @brief Warns when the enclosing scope allocates more than its budget
+ *
+ * Used through ALLOC_BUDGET, which compiles to nothing unless allocation
+ * counting is enabled.
+ */
+class AllocBudget
+{
+public:
+    AllocBudget(const char *operation, quint64 maxAllocations)
+        : m_operation(operation), m_maxAllocations(maxAllocations) {}
+    ~AllocBudget();
+
+    AllocBudget(const AllocBudget &) = delete;
+    AllocBudget &operator=(const AllocBudget &) = delete;
+
+private:
+    const char *m_operation;
+    quint64 m_maxAllocations;
+    AllocScope m_scope;
+};
+
+#ifdef ECIM_COUNT_ALLOCATIONS
+#define ALLOC_BUDGET_CONCAT_INNER(a, b) a##b
+#define ALLOC_BUDGET_CONCAT(a, b) ALLOC_BUDGET_CONCAT_INNER(a, b)
+#define ALLOC_BUDGET(operation, maxAllocations) \
+    AllocBudget ALLOC_BUDGET_CONCAT(allocBudget_, __LINE__)(operation, maxAllocations)
+#else
+#define ALLOC_BUDGET(operation, maxAllocations) ((void)0)
+#endif
+
+#endif // ALLOCCOUNTER_H
@@ -0,0 +1,104 @@
+#include "utils/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = std::numeric_limits<qint64>::max();
+    m_max = 0;
+}
+
+int LatencyHistogram::bucketOf(qint64 ns)
+{
+    quint64 value = ns > 0 ? static_cast<quint64>(ns) : 0;
+
+    // Values below SUB_BUCKETS get one bucket each in magnitude 0
+    if (value < quint64(SUB_BUCKETS))
+    {
+        return static_cast<int>(value);
+    }
+
+    int highBit = 63;
+    while (!(value >> highBit))
+    {
+        --highBit;
+    }
+
+    int magnitude = highBit - SUB_BUCKET_BITS + 1;
+    if (magnitude >= MAGNITUDES)
+    {
+        return BUCKET_COUNT - 1;
+    }
+
+    // The bits after the leading one pick the linear slice within the magnitude
+    int subBucket = static_cast<int>((value >> (magnitude - 1)) & (SUB_BUCKETS - 1));
+    return magnitude * SUB_BUCKETS + subBucket;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int bucket)
+{
+    int magnitude = bucket / SUB_BUCKETS;
+    int subBucket = bucket % SUB_BUCKETS;
+    if (magnitude == 0)
+    {
+        return subBucket;
+    }
+
+    qint64 base = qint64(1) << (magnitude + SUB_BUCKET_BITS - 1);
+    qint64 width = qint64(1) << (magnitude - 1);
+    return base + (subBucket + 1) * width - 1;
+}
+
+void LatencyHistogram::record(qint64 ns)
+{
+    ++m_buckets[bucketOf(ns)];
+    ++m_count;
+    m_sum += static_cast<double>(ns);
+    m_min = std::min(m_min, ns);
+    m_max = std::max(m_max, ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    quint64 rank = static_cast<quint64>(std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * m_count));
+    rank = std::max<quint64>(rank, 1);
+
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            // The bucket bound can overshoot the largest value actually seen
+            return std::min(bucketUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
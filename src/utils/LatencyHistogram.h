@@ -0,0 +1,48 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief Fixed-size log-linear histogram of durations in nanoseconds
+ *
+ * Values are bucketed by their power of two and then linearly into
+ * SUB_BUCKETS slices, so every bucket is within 1/SUB_BUCKETS of its
+ * values (about 6%) from nanoseconds to minutes. Recording is a few
+ * integer operations and never allocates.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAGNITUDES = 48; // Up to 2^48 ns, about three days
+    static constexpr int BUCKET_COUNT = MAGNITUDES * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    void record(qint64 ns);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    quint64 count() const { return m_count; }
+    qint64 min() const { return m_count ? m_min : 0; }
+    qint64 max() const { return m_max; }
+    qint64 mean() const { return m_count ? static_cast<qint64>(m_sum / m_count) : 0; }
+
+    /// Upper bound of the bucket holding the given percentile (0-100)
+    qint64 percentile(double percent) const;
+
+    static int bucketOf(qint64 ns);
+    static qint64 bucketUpperBound(int bucket);
+
+private:
+    std::array<quint64, BUCKET_COUNT> m_buckets;
+    quint64 m_count;
+    double m_sum;
+    qint64 m_min;
+    qint64 m_max;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,307 @@
+#include "utils/SiValue.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    bool isAsciiDigit(QChar c)
+    {
+        return c.unicode() >= u'0' && c.unicode() <= u'9';
+    }
+
+    /// Fixed-size scratch buffer for the normalized number handed to from_chars
+    class NumberBuffer
+    {
+    public:
+        bool push(char c)
+        {
+            if (m_length + 1 >= sizeof(m_data))
+            {
+                return false;
+            }
+            m_data[m_length++] = c;
+            return true;
+        }
+
+        const char *begin() const { return m_data; }
+        const char *end() const { return m_data + m_length; }
+
+    private:
+        char m_data[64];
+        std::size_t m_length = 0;
+    };
+
+    /// Copy ASCII digits starting at pos, returns false if the buffer overflows
+    bool pushDigits(QStringView text, qsizetype &pos, NumberBuffer &buffer, bool &any)
+    {
+        while (pos < text.size() && isAsciiDigit(text[pos]))
+        {
+            if (!buffer.push(static_cast<char>(text[pos].unicode())))
+            {
+                return false;
+            }
+            any = true;
+            ++pos;
+        }
+        return true;
+    }
+
+    /// Divide by the prefix scale using an exact power of ten for negative exponents
+    double toPrefix(double value, int exponent)
+    {
+        return exponent < 0 ? value * std::pow(10.0, -exponent) : value / std::pow(10.0, exponent);
+    }
+
+    double fromPrefix(double value, int exponent)
+    {
+        return exponent < 0 ? value / std::pow(10.0, -exponent) : value * std::pow(10.0, exponent);
+    }
+
+    void skipSpaces(QStringView text, qsizetype &pos)
+    {
+        while (pos < text.size() && text[pos].isSpace())
+        {
+            ++pos;
+        }
+    }
+}
+
+int SiValue::prefixIndex(QChar symbol)
+{
+    switch (symbol.unicode())
+    {
+    case u'p':
+        return 0;
+    case u'n':
+        return 1;
+    case u'u':
+    case u'μ': // Greek small letter mu
+    case u'µ': // Micro sign
+        return 2;
+    case u'm':
+        return 3;
+    case u'R': // RKM notation uses R as the decimal point for base units (4R7)
+    case u'r':
+        return BASE_PREFIX;
+    case u'k':
+    case u'K':
+        return 5;
+    case u'M':
+        return 6;
+    case u'G':
+        return 7;
+    default:
+        return -1;
+    }
+}
+
+int SiValue::decompose(double value, double &mantissa, int precision)
+{
+    double magnitude = std::fabs(value);
+
+    // Zero, non-finite values and values below the smallest prefix stay in base units
+    if (!std::isfinite(value) || magnitude < PREFIXES[0].scale)
+    {
+        mantissa = value;
+        return BASE_PREFIX;
+    }
+
+    int index = PREFIX_COUNT - 1;
+    while (index > 0 && magnitude < PREFIXES[index].scale)
+    {
+        --index;
+    }
+
+    // Rounding to the requested digits can carry over, e.g. 999.9k -> "1e+03k"
+    double scaled = toPrefix(magnitude, PREFIXES[index].exponent);
+    if (index < PREFIX_COUNT - 1 && precision > 0)
+    {
+        double carryLimit = 1000.0 - 0.5 * std::pow(10.0, 3 - precision);
+        if (scaled >= carryLimit)
+        {
+            ++index;
+            scaled = toPrefix(magnitude, PREFIXES[index].exponent);
+        }
+    }
+
+    mantissa = value < 0 ? -scaled : scaled;
+    return index;
+}
+
+std::size_t SiValue::format(double value, char *buffer, std::size_t size, int precision)
+{
+    if (!buffer || size == 0)
+    {
+        return 0;
+    }
+
+    double mantissa = 0.0;
+    int index = decompose(value, mantissa, precision);
+
+    char *last = buffer + size - 1; // Reserve space for the terminator
+    std::to_chars_result result = std::to_chars(buffer, last, mantissa, std::chars_format::general, precision);
+    if (result.ec != std::errc())
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    char *out = result.ptr;
+    for (const char *symbol = PREFIXES[index].displaySymbol; *symbol; ++symbol)
+    {
+        if (out == last)
+        {
+            buffer[0] = '\0';
+            return 0;
+        }
+        *out++ = *symbol;
+    }
+    *out = '\0';
+
+    return static_cast<std::size_t>(out - buffer);
+}
+
+QString SiValue::toString(double value, int precision)
+{
+    char buffer[BUFFER_SIZE];
+    std::size_t length = format(value, buffer, sizeof(buffer), precision);
+    return QString::fromUtf8(buffer, static_cast<qsizetype>(length));
+}
+
+bool SiValue::parse(QStringView text, double &value, QStringView *unit)
+{
+    NumberBuffer number;
+    qsizetype pos = 0;
+    bool hasDigits = false;
+    bool hasPoint = false;
+    bool hasExponent = false;
+
+    skipSpaces(text, pos);
+
+    if (pos < text.size() && (text[pos] == u'-' || text[pos] == u'+'))
+    {
+        if (text[pos] == u'-')
+        {
+            number.push('-');
+        }
+        ++pos;
+    }
+
+    // RKM values may start with the prefix, which then stands for "0." (R47, k5)
+    int index = BASE_PREFIX;
+    bool leadingPrefix = false;
+    if (pos + 1 < text.size() && prefixIndex(text[pos]) >= 0 && isAsciiDigit(text[pos + 1]))
+    {
+        index = prefixIndex(text[pos]);
+        leadingPrefix = true;
+        hasPoint = true;
+        ++pos;
+        number.push('0');
+        number.push('.');
+        if (!pushDigits(text, pos, number, hasDigits))
+        {
+            return false;
+        }
+    }
+
+    // Integer and fractional part, accepting ',' as decimal separator
+    if (!pushDigits(text, pos, number, hasDigits))
+    {
+        return false;
+    }
+    if (pos < text.size() && (text[pos] == u'.' || text[pos] == u','))
+    {
+        number.push('.');
+        hasPoint = true;
+        ++pos;
+        if (!pushDigits(text, pos, number, hasDigits))
+        {
+            return false;
+        }
+    }
+    if (!hasDigits)
+    {
+        return false;
+    }
+
+    // Exponent, only when 'e' is followed by digits so "1e" isn't swallowed
+    if (pos < text.size() && (text[pos] == u'e' || text[pos] == u'E'))
+    {
+        qsizetype next = pos + 1;
+        if (next < text.size() && (text[next] == u'+' || text[next] == u'-'))
+        {
+            ++next;
+        }
+        if (next < text.size() && isAsciiDigit(text[next]))
+        {
+            number.push('e');
+            if (text[pos + 1] == u'-')
+            {
+                number.push('-');
+            }
+            pos = next;
+            bool exponentDigits = false;
+            if (!pushDigits(text, pos, number, exponentDigits))
+            {
+                return false;
+            }
+            hasExponent = true;
+        }
+    }
+
+    skipSpaces(text, pos);
+
+    // Prefix, which in RKM notation also marks the decimal point (4k7, 4R7)
+    if (!leadingPrefix && pos < text.size())
+    {
+        int candidate = prefixIndex(text[pos]);
+        if (candidate >= 0)
+        {
+            index = candidate;
+            ++pos;
+
+            if (pos < text.size() && isAsciiDigit(text[pos]))
+            {
+                if (hasPoint || hasExponent)
+                {
+                    return false;
+                }
+                number.push('.');
+                bool fractionDigits = false;
+                if (!pushDigits(text, pos, number, fractionDigits))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Whatever is left has to be a unit made of letters (F, H, Ω, ohm, ...)
+    skipSpaces(text, pos);
+    qsizetype unitStart = pos;
+    while (pos < text.size() && text[pos].isLetter())
+    {
+        ++pos;
+    }
+    qsizetype unitEnd = pos;
+    skipSpaces(text, pos);
+    if (pos != text.size())
+    {
+        return false;
+    }
+
+    double mantissa = 0.0;
+    std::from_chars_result result = std::from_chars(number.begin(), number.end(), mantissa);
+    if (result.ec != std::errc() || result.ptr != number.end())
+    {
+        return false;
+    }
+
+    value = fromPrefix(mantissa, PREFIXES[index].exponent);
+    if (unit)
+    {
+        *unit = text.sliced(unitStart, unitEnd - unitStart);
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef SIVALUE_H
+#define SIVALUE_H
+
+#include <QString>
+#include <QStringView>
+#include <cstddef>
+
+/**
+ * @brief SI prefix formatting and parsing for component values
+ *
+ * One constexpr prefix table drives the table model, the component dialog,
+ * search and importers. The formatting and parsing primitives work on
+ * caller-provided buffers and views and never allocate.
+ */
+class SiValue
+{
+public:
+    struct Prefix
+    {
+        char16_t symbol;             ///< Prefix character, 0 for the base unit
+        const char *displaySymbol;   ///< UTF-8 symbol used in formatted output
+        const char *translationKey;  ///< Key of the multiplier name in the language file
+        int exponent;                ///< Power of ten
+        double scale;                ///< 10^exponent
+    };
+
+    static constexpr Prefix PREFIXES[] = {
+        {u'p', "p", "multipliers.pico", -12, 1e-12},
+        {u'n', "n", "multipliers.nano", -9, 1e-9},
+        {u'u', "μ", "multipliers.micro", -6, 1e-6},
+        {u'm', "m", "multipliers.milli", -3, 1e-3},
+        {0, "", "multipliers.base", 0, 1.0},
+        {u'k', "k", "multipliers.kilo", 3, 1e3},
+        {u'M', "M", "multipliers.mega", 6, 1e6},
+        {u'G', "G", "multipliers.giga", 9, 1e9}};
+
+    static constexpr int PREFIX_COUNT = static_cast<int>(sizeof(PREFIXES) / sizeof(PREFIXES[0]));
+    static constexpr int BASE_PREFIX = 4;
+
+    /// Large enough for any value formatted by format() at the default precision
+    static constexpr std::size_t BUFFER_SIZE = 32;
+
+    /**
+     * @brief Pick the prefix for a value and scale it into [1, 1000)
+     * @param value Value in base units
+     * @param mantissa Receives the scaled value
+     * @param precision Significant digits used to decide rounding rollover
+     * @return Index into PREFIXES
+     */
+    static int decompose(double value, double &mantissa, int precision = 3);
+
+    /**
+     * @brief Format a value with an SI prefix into a UTF-8 buffer, e.g. "4.7k"
+     * @return Number of bytes written (excluding the terminating null), 0 if the buffer is too small
+     */
+    static std::size_t format(double value, char *buffer, std::size_t size, int precision = 3);
+
+    /// Convenience wrapper returning a QString
+    static QString toString(double value, int precision = 3);
+
+    /**
+     * @brief Parse a value such as "4k7", "100n", "2.2uF", "4R7", "R47" or "10 kΩ"
+     * @param text Input text; a trailing unit is accepted and returned in unit
+     * @param value Receives the value in base units
+     * @param unit Optional, receives the unit text after the number and prefix
+     * @return true if the whole text was a valid value
+     */
+    static bool parse(QStringView text, double &value, QStringView *unit = nullptr);
+
+    /// Index into PREFIXES for a prefix character, -1 if it isn't one
+    static int prefixIndex(QChar symbol);
+
+private:
+    SiValue() = delete;
+};
+
+#endif // SIVALUE_H
@@ -0,0 +1,198 @@
+#include "utils/StallWatchdog.h"
+#include "utils/Trace.h"
+
+#include <QDebug>
+#include <QThread>
+#include <algorithm>
+
+namespace
+{
+    double toMilliseconds(qint64 ns)
+    {
+        return static_cast<double>(ns) / 1e6;
+    }
+}
+
+StallWatchdog &StallWatchdog::instance()
+{
+    static StallWatchdog instance;
+    return instance;
+}
+
+StallWatchdog::StallWatchdog()
+    : QObject(nullptr), m_thread(nullptr), m_guiThreadId(0), m_lastBeatNs(0), m_thresholdNs(0), m_running(false), m_stallCount(0)
+{
+    m_heartbeat.setTimerType(Qt::PreciseTimer);
+    m_heartbeat.setInterval(HEARTBEAT_MS);
+    connect(&m_heartbeat, &QTimer::timeout, this, &StallWatchdog::onHeartbeat);
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    stop();
+}
+
+void StallWatchdog::start(int stallThresholdMs)
+{
+    if (stallThresholdMs <= 0)
+    {
+        stop();
+        return;
+    }
+
+    // A threshold near the heartbeat interval would report every beat as a stall
+    stallThresholdMs = std::max(stallThresholdMs, MIN_THRESHOLD_MS);
+    m_thresholdNs.store(qint64(stallThresholdMs) * 1000000);
+    if (m_thread)
+    {
+        return;
+    }
+
+    // Stalls are attributed through the span stack of this thread
+    Trace::setSpanTracking(true);
+    m_guiThreadId = Trace::currentThreadId();
+
+    m_lastBeatNs.store(Trace::nowNs());
+    m_running.store(true);
+    m_heartbeat.start();
+
+    m_thread = QThread::create([this]()
+                               { monitor(); });
+    m_thread->setObjectName("StallWatchdog");
+    m_thread->start(QThread::LowPriority);
+}
+
+void StallWatchdog::stop()
+{
+    if (!m_thread)
+    {
+        return;
+    }
+
+    m_heartbeat.stop();
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_running.store(false);
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    Trace::setSpanTracking(false);
+}
+
+void StallWatchdog::onHeartbeat()
+{
+    qint64 now = Trace::nowNs();
+    qint64 lateNs = std::max<qint64>(0, now - m_lastBeatNs.load() - qint64(HEARTBEAT_MS) * 1000000);
+    m_lastBeatNs.store(now);
+
+    QMutexLocker locker(&m_statsMutex);
+    m_latency.record(lateNs);
+}
+
+void StallWatchdog::monitor()
+{
+    bool stalled = false;
+    qint64 stalledBeatNs = 0;
+    QString operation;
+
+    QMutexLocker locker(&m_wakeMutex);
+    while (m_running.load())
+    {
+        // Poll a few times per threshold so a stall is seen soon after it crosses it
+        qint64 thresholdNs = m_thresholdNs.load();
+        unsigned long pollMs = static_cast<unsigned long>(std::clamp<qint64>(thresholdNs / 4000000, 5, 250));
+        m_wake.wait(&m_wakeMutex, pollMs);
+        if (!m_running.load())
+        {
+            break;
+        }
+
+        qint64 lastBeatNs = m_lastBeatNs.load();
+        qint64 sinceBeatNs = Trace::nowNs() - lastBeatNs;
+
+        if (!stalled && sinceBeatNs > thresholdNs)
+        {
+            // Logged right away so a loop that never recovers still leaves a trail
+            stalled = true;
+            stalledBeatNs = lastBeatNs;
+            const char *span = Trace::currentSpan(m_guiThreadId);
+            operation = span ? QString(span) : QString();
+            qWarning().noquote() << QString("Event loop stalled for %1 ms so far in %2")
+                                        .arg(toMilliseconds(sinceBeatNs), 0, 'f', 0)
+                                        .arg(span ? operation : QString("untraced code"));
+        }
+        else if (stalled && lastBeatNs == stalledBeatNs)
+        {
+            // Still stuck; a traced operation may have started since the stall was detected
+            if (operation.isEmpty())
+            {
+                if (const char *span = Trace::currentSpan(m_guiThreadId))
+                {
+                    operation = span;
+                }
+            }
+        }
+        else if (stalled)
+        {
+            // The heartbeat fired again; the stall lasted from the previous beat until then
+            stalled = false;
+            qint64 durationNs = lastBeatNs - stalledBeatNs - qint64(HEARTBEAT_MS) * 1000000;
+            if (operation.isEmpty())
+            {
+                operation = "untraced code";
+            }
+            qWarning().noquote() << QString("Event loop stalled for %1 ms in %2")
+                                        .arg(toMilliseconds(durationNs), 0, 'f', 0)
+                                        .arg(operation);
+            recordStall(durationNs, operation);
+        }
+    }
+}
+
+void StallWatchdog::recordStall(qint64 durationNs, const QString &operation)
+{
+    QMutexLocker locker(&m_statsMutex);
+    ++m_stallCount;
+    m_stalls.push_back({QDateTime::currentDateTime(), durationNs, operation});
+    if (m_stalls.size() > STALL_LOG_CAPACITY)
+    {
+        m_stalls.pop_front();
+    }
+}
+
+LatencyHistogram StallWatchdog::latency() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_latency;
+}
+
+std::vector<StallWatchdog::Stall> StallWatchdog::stalls() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return std::vector<Stall>(m_stalls.begin(), m_stalls.end());
+}
+
+quint64 StallWatchdog::stallCount() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_stallCount;
+}
+
+void StallWatchdog::logSummary() const
+{
+    LatencyHistogram histogram = latency();
+    if (histogram.count() == 0)
+    {
+        return;
+    }
+
+    qInfo().noquote() << QString("Event loop latency: p50 %1 ms, p99 %2 ms, max %3 ms over %4 heartbeats, %5 stalls")
+                             .arg(toMilliseconds(histogram.percentile(50)), 0, 'f', 1)
+                             .arg(toMilliseconds(histogram.percentile(99)), 0, 'f', 1)
+                             .arg(toMilliseconds(histogram.max()), 0, 'f', 1)
+                             .arg(histogram.count())
+                             .arg(stallCount());
+}
@@ -0,0 +1,85 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QDateTime>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include "utils/LatencyHistogram.h"
+
+class QThread;
+
+/**
+ * @brief Detects GUI event loop stalls and names the operation that caused them
+ *
+ * A timer on the GUI thread beats every HEARTBEAT_MS and records how late
+ * it fired into a session-wide latency histogram. A watchdog thread checks
+ * the time since the last beat; once it exceeds the stall threshold it
+ * asks Trace for the innermost span open on the GUI thread and logs the
+ * stall, then logs its total duration when the loop recovers.
+ */
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stall
+    {
+        QDateTime timestamp;
+        qint64 durationNs;
+        QString operation;
+    };
+
+    static StallWatchdog &instance();
+
+    StallWatchdog(const StallWatchdog &) = delete;
+    StallWatchdog &operator=(const StallWatchdog &) = delete;
+
+    /// Start monitoring the calling (GUI) thread; 0 ms stops the watchdog, lower
+    /// thresholds than MIN_THRESHOLD_MS are raised to it
+    void start(int stallThresholdMs);
+    void stop();
+    bool isRunning() const { return m_thread != nullptr; }
+    int stallThresholdMs() const { return static_cast<int>(m_thresholdNs.load() / 1000000); }
+
+    /// Event loop latency: how late each heartbeat fired
+    LatencyHistogram latency() const;
+    std::vector<Stall> stalls() const;
+    quint64 stallCount() const;
+
+    void logSummary() const;
+
+    static constexpr int HEARTBEAT_MS = 20;
+    static constexpr int MIN_THRESHOLD_MS = 2 * HEARTBEAT_MS;
+    static constexpr int STALL_LOG_CAPACITY = 100;
+
+private:
+    StallWatchdog();
+    ~StallWatchdog() override;
+
+    void onHeartbeat();
+    void monitor();
+    void recordStall(qint64 durationNs, const QString &operation);
+
+    QTimer m_heartbeat;
+    QThread *m_thread;
+    int m_guiThreadId;
+
+    std::atomic<qint64> m_lastBeatNs;
+    std::atomic<qint64> m_thresholdNs;
+    std::atomic<bool> m_running;
+    QMutex m_wakeMutex;
+    QWaitCondition m_wake;
+
+    mutable QMutex m_statsMutex;
+    LatencyHistogram m_latency;
+    std::deque<Stall> m_stalls;
+    quint64 m_stallCount;
+};
+
+#endif // STALLWATCHDOG_H
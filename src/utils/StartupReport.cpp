@@ -0,0 +1,160 @@
+#include "utils/StartupReport.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QTextStream>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    thread_local int scopeDepth = 0;
+
+    double toMilliseconds(qint64 ns)
+    {
+        return static_cast<double>(ns) / 1e6;
+    }
+}
+
+StartupReport &StartupReport::instance()
+{
+    static StartupReport instance;
+    return instance;
+}
+
+StartupReport::StartupReport()
+    : m_enabled(false), m_finished(false)
+{
+    m_timer.start();
+}
+
+void StartupReport::start()
+{
+    QMutexLocker locker(&m_mutex);
+    m_timer.restart();
+    m_phases.clear();
+    m_finished = false;
+}
+
+void StartupReport::record(const char *name, int depth, qint64 startNs, qint64 durationNs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_phases.push_back({name, depth, startNs, durationNs});
+}
+
+void StartupReport::mark(const char *name)
+{
+    qint64 now = elapsedNs();
+    record(name, 0, now, -1);
+    qInfo().noquote() << QString("Startup: %1 after %2 ms").arg(name).arg(toMilliseconds(now), 0, 'f', 1);
+}
+
+void StartupReport::finish()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_finished)
+        {
+            return;
+        }
+        m_finished = true;
+    }
+
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    std::fputs(qPrintable(toText()), stderr);
+    std::fflush(stderr);
+
+    if (!m_jsonPath.isEmpty())
+    {
+        QSaveFile file(m_jsonPath);
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented)) < 0 ||
+            !file.commit())
+        {
+            qWarning() << "Could not write startup report to" << m_jsonPath << ":" << file.errorString();
+        }
+    }
+}
+
+std::vector<StartupReport::Phase> StartupReport::sortedPhases() const
+{
+    QMutexLocker locker(&m_mutex);
+    std::vector<Phase> phases = m_phases;
+
+    // Timers are recorded when they end; report them in the order they started
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase &a, const Phase &b)
+                     { return a.startNs < b.startNs; });
+    return phases;
+}
+
+QString StartupReport::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+    out << "Startup report (ms since process start)\n";
+    out << "     start  duration  phase\n";
+    for (const Phase &phase : sortedPhases())
+    {
+        out << QString("%1  ").arg(toMilliseconds(phase.startNs), 8, 'f', 2);
+        if (phase.durationNs >= 0)
+        {
+            out << QString("%1  ").arg(toMilliseconds(phase.durationNs), 8, 'f', 2);
+        }
+        else
+        {
+            out << "       *  ";
+        }
+        out << QString(phase.depth * 2, ' ') << phase.name << "\n";
+    }
+    out.flush();
+    return text;
+}
+
+QJsonObject StartupReport::toJson() const
+{
+    QJsonArray phases;
+    QJsonArray milestones;
+    for (const Phase &phase : sortedPhases())
+    {
+        QJsonObject entry;
+        entry["name"] = phase.name;
+        if (phase.durationNs >= 0)
+        {
+            entry["depth"] = phase.depth;
+            entry["startNs"] = phase.startNs;
+            entry["durationNs"] = phase.durationNs;
+            phases.append(entry);
+        }
+        else
+        {
+            entry["atNs"] = phase.startNs;
+            milestones.append(entry);
+        }
+    }
+
+    QJsonObject root;
+    root["version"] = QCoreApplication::applicationVersion();
+    root["totalNs"] = elapsedNs();
+    root["phases"] = phases;
+    root["milestones"] = milestones;
+    return root;
+}
+
+ScopedTimer::ScopedTimer(const char *name)
+    : m_name(name), m_depth(scopeDepth++), m_startNs(StartupReport::instance().elapsedNs())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    --scopeDepth;
+    StartupReport &report = StartupReport::instance();
+    report.record(m_name, m_depth, m_startNs, report.elapsedNs() - m_startNs);
+}
@@ -0,0 +1,88 @@
+#ifndef STARTUPREPORT_H
+#define STARTUPREPORT_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <vector>
+
+/**
+ * @brief Per-phase timings of application startup
+ *
+ * Phases are recorded by ScopedTimer and milestones by mark(), both in
+ * nanoseconds since start(). Recording is always on and costs a clock read
+ * and a vector append; the report is only printed and written when enabled
+ * with --startup-report.
+ */
+class StartupReport
+{
+public:
+    struct Phase
+    {
+        const char *name;
+        int depth;          ///< Nesting level of the timer on its thread
+        qint64 startNs;     ///< Since start()
+        qint64 durationNs;  ///< -1 for milestones
+    };
+
+    static StartupReport &instance();
+
+    StartupReport(const StartupReport &) = delete;
+    StartupReport &operator=(const StartupReport &) = delete;
+
+    /// Reference point for all timings, call first thing in main()
+    void start();
+    qint64 elapsedNs() const { return m_timer.nsecsElapsed(); }
+
+    void record(const char *name, int depth, qint64 startNs, qint64 durationNs);
+
+    /// Record a point in time such as the first paint, also logged with qInfo
+    void mark(const char *name);
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    void setJsonPath(const QString &path) { m_jsonPath = path; }
+
+    /// End of startup; prints the breakdown and writes the JSON file once, if enabled
+    void finish();
+
+    QString toText() const;
+    QJsonObject toJson() const;
+
+private:
+    StartupReport();
+
+    std::vector<Phase> sortedPhases() const;
+
+    QElapsedTimer m_timer;
+    mutable QMutex m_mutex;
+    std::vector<Phase> m_phases;
+    QString m_jsonPath;
+    bool m_enabled;
+    bool m_finished;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a startup phase
+ *
+ * @code
+ * ScopedTimer timer("config.load");
+ * @endcode
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char *name);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    const char *m_name;
+    int m_depth;
+    qint64 m_startNs;
+};
+
+#endif // STARTUPREPORT_H
@@ -0,0 +1,260 @@
+#include "utils/Trace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+std::atomic<int> Trace::s_mode{0};
+
+namespace
+{
+    struct Event
+    {
+        const char *category;
+        const char *name;
+        qint64 startNs;
+        qint64 durationNs;
+    };
+
+    constexpr int MAX_SPAN_DEPTH = 64;
+
+    /// Written only by its own thread; writeJson() reads up to the published head
+    struct ThreadBuffer
+    {
+        int tid = 0;
+        QString threadName;
+        std::array<Event, Trace::BUFFER_CAPACITY> events;
+        std::atomic<quint64> head{0};
+
+        // Read by other threads through Trace::currentSpan(int)
+        std::array<std::atomic<const char *>, MAX_SPAN_DEPTH> spans{};
+        std::atomic<int> spanDepth{0};
+    };
+
+    struct Registry
+    {
+        QMutex mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    ThreadBuffer &threadBuffer()
+    {
+        // The registry keeps buffers of finished threads so their events still get written
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer)
+        {
+            buffer = std::make_shared<ThreadBuffer>();
+
+            QThread *thread = QThread::currentThread();
+            if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+            {
+                buffer->threadName = "main";
+            }
+            else
+            {
+                buffer->threadName = thread->objectName();
+            }
+
+            Registry &reg = registry();
+            QMutexLocker locker(&reg.mutex);
+            buffer->tid = static_cast<int>(reg.buffers.size()) + 1;
+            if (buffer->threadName.isEmpty())
+            {
+                buffer->threadName = QString("thread %1").arg(buffer->tid);
+            }
+            reg.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void appendEscaped(QByteArray &out, const char *text)
+    {
+        for (const char *c = text; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                out += '\\';
+            }
+            out += *c;
+        }
+    }
+
+    void appendMicroseconds(QByteArray &out, qint64 ns)
+    {
+        out += QByteArray::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+    }
+}
+
+void Trace::setEnabled(bool enabled)
+{
+    setMode(RecordEvents, enabled);
+}
+
+void Trace::setSpanTracking(bool enabled)
+{
+    setMode(TrackSpans, enabled);
+}
+
+void Trace::setMode(int flag, bool enabled)
+{
+    if (enabled)
+    {
+        s_mode.fetch_or(flag, std::memory_order_relaxed);
+    }
+    else
+    {
+        s_mode.fetch_and(~flag, std::memory_order_relaxed);
+    }
+}
+
+qint64 Trace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void Trace::record(const char *category, const char *name, qint64 startNs, qint64 durationNs)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    quint64 head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % BUFFER_CAPACITY] = {category, name, startNs, durationNs};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::pushSpan(const char *name)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    int depth = buffer.spanDepth.load(std::memory_order_relaxed);
+    if (depth < MAX_SPAN_DEPTH)
+    {
+        buffer.spans[depth].store(name, std::memory_order_relaxed);
+    }
+    buffer.spanDepth.store(depth + 1, std::memory_order_release);
+}
+
+void Trace::popSpan()
+{
+    ThreadBuffer &buffer = threadBuffer();
+    buffer.spanDepth.store(buffer.spanDepth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+}
+
+namespace
+{
+    const char *innermostSpan(const ThreadBuffer &buffer)
+    {
+        int depth = buffer.spanDepth.load(std::memory_order_acquire);
+        if (depth <= 0)
+        {
+            return nullptr;
+        }
+        return buffer.spans[std::min(depth, MAX_SPAN_DEPTH) - 1].load(std::memory_order_relaxed);
+    }
+}
+
+const char *Trace::currentSpan()
+{
+    return innermostSpan(threadBuffer());
+}
+
+int Trace::currentThreadId()
+{
+    return threadBuffer().tid;
+}
+
+const char *Trace::currentSpan(int threadId)
+{
+    Registry &reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    if (threadId < 1 || threadId > static_cast<int>(reg.buffers.size()))
+    {
+        return nullptr;
+    }
+    return innermostSpan(*reg.buffers[threadId - 1]);
+}
+
+void Trace::clear()
+{
+    Registry &reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    for (const auto &buffer : reg.buffers)
+    {
+        buffer->head.store(0, std::memory_order_release);
+    }
+}
+
+bool Trace::writeJson(const QString &filePath)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        Registry &reg = registry();
+        QMutexLocker locker(&reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    auto separator = [&out, &first]()
+    {
+        if (!first)
+        {
+            out += ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto &buffer : buffers)
+    {
+        separator();
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + QByteArray::number(pid) +
+               ",\"tid\":" + QByteArray::number(buffer->tid) + ",\"args\":{\"name\":\"";
+        appendEscaped(out, buffer->threadName.toUtf8().constData());
+        out += "\"}}";
+
+        // Events other threads are writing right now may be torn; the viewer copes with a few
+        quint64 head = buffer->head.load(std::memory_order_acquire);
+        quint64 begin = head > quint64(BUFFER_CAPACITY) ? head - BUFFER_CAPACITY : 0;
+        for (quint64 i = begin; i < head; ++i)
+        {
+            const Event &event = buffer->events[i % BUFFER_CAPACITY];
+            separator();
+            out += "{\"ph\":\"X\",\"cat\":\"";
+            appendEscaped(out, event.category);
+            out += "\",\"name\":\"";
+            appendEscaped(out, event.name);
+            out += "\",\"ts\":";
+            appendMicroseconds(out, event.startNs);
+            out += ",\"dur\":";
+            appendMicroseconds(out, event.durationNs);
+            out += ",\"pid\":" + QByteArray::number(pid) + ",\"tid\":" + QByteArray::number(buffer->tid) + "}";
+        }
+    }
+    out += "\n]}\n";
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit())
+    {
+        qWarning() << "Could not write trace to" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    qInfo() << "Trace written to" << filePath;
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Opt-in span tracing exported in the Chrome trace-event format
+ *
+ * Spans are recorded into a fixed-size ring buffer per thread, so the
+ * recording thread never locks or allocates once its buffer exists and
+ * only the most recent events are kept. While tracing is disabled a span
+ * costs one relaxed atomic load.
+ *
+ * Independently of recording, span tracking keeps a stack of the open span
+ * names per thread so other threads can ask what a thread is doing; the
+ * stall watchdog turns it on to attribute event loop stalls.
+ *
+ * Tracing is enabled by the ECIM_TRACE environment variable (the output
+ * path, or "1" for trace.json) or by "diagnostics.trace" in config.json.
+ * writeJson() produces a file that chrome://tracing and Perfetto open.
+ */
+class Trace
+{
+public:
+    Trace() = delete;
+
+    enum Mode
+    {
+        RecordEvents = 0x1,
+        TrackSpans = 0x2
+    };
+
+    static bool isEnabled() { return s_mode.load(std::memory_order_relaxed) & RecordEvents; }
+    static void setEnabled(bool enabled);
+    static void setSpanTracking(bool enabled);
+    static int mode() { return s_mode.load(std::memory_order_relaxed); }
+
+    /// Monotonic clock used for all events
+    static qint64 nowNs();
+
+    /// Category and name must be string literals, they are stored by pointer
+    static void record(const char *category, const char *name, qint64 startNs, qint64 durationNs);
+
+    /// Name of the innermost open span on this thread, or nullptr
+    static const char *currentSpan();
+
+    /// Stable ID of the calling thread, usable with currentSpan(int) from any thread
+    static int currentThreadId();
+    static const char *currentSpan(int threadId);
+
+    /// Write all buffered events; returns false and logs a warning on failure
+    static bool writeJson(const QString &filePath);
+
+    static void clear();
+
+    /// Events kept per thread before the oldest are overwritten
+    static constexpr int BUFFER_CAPACITY = 16384;
+
+private:
+    friend class TraceScope;
+
+    static void pushSpan(const char *name);
+    static void popSpan();
+
+    static void setMode(int flag, bool enabled);
+
+    static std::atomic<int> s_mode;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a complete ("X") trace event
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name)
+        : m_category(category), m_name(name), m_mode(Trace::mode()), m_startNs(-1)
+    {
+        if (m_mode)
+        {
+            Trace::pushSpan(name);
+            if (m_mode & Trace::RecordEvents)
+            {
+                m_startNs = Trace::nowNs();
+            }
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_mode)
+        {
+            Trace::popSpan();
+            if (m_mode & Trace::RecordEvents)
+            {
+                Trace::record(m_category, m_name, m_startNs, Trace::nowNs() - m_startNs);
+            }
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *m_category;
+    const char *m_name;
+    int m_mode; // Captured once so a mode change mid-span keeps push and pop balanced
+    qint64 m_startNs;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/// Trace the enclosing scope, e.g. TRACE_SCOPE("db", "fetchAllComponents")
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+
+#endif // TRACE_H
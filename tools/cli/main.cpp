@@ -0,0 +1,471 @@
+/**
+ * @brief Headless inventory tool for scripts and batch jobs
+ *
+ * Usage:
+ *   ecim-cli [--db <file>] [--config <config.json>] <command> [args]
+ *
+ * Commands:
+ *   query [--category C] [--search S] [--low-stock] [--limit N]
+ *                         Matching components as JSON Lines
+ *   search <term>         Same as query --search <term>
+ *   stats                 Totals per category as one JSON object
+ *   adjust <file|->       Apply "id,delta" lines to quantities
+ *   import <file|->       Add components from JSON Lines, or from a .csv/.tsv file
+ *   export [file|-]       Write components as JSON Lines, or CSV for a .csv file
+ *                         (accepts the query filters)
+ *   vacuum                Compact the database file
+ *
+ * Each run works inside one transaction, so a failed batch leaves the
+ * database untouched. Results are written as they are read, and batch input
+ * is applied in fixed-size chunks, so memory does not grow with the input.
+ */
+#include "config/AppConfig.h"
+#include "database/ComponentExporter.h"
+#include "database/CsvImporter.h"
+#include "database/DatabaseManager.h"
+#include "models/ComponentJson.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QRegularExpression>
+#include <cstdio>
+
+namespace
+{
+    constexpr int BATCH_SIZE = 10000;
+    constexpr int MAX_REPORTED_ERRORS = 100;
+
+    /// Buffered JSON writer on stdout or a file
+    class JsonWriter
+    {
+    public:
+        bool open(const QString &path)
+        {
+            if (path.isEmpty() || path == "-")
+            {
+                return m_file.open(stdout, QIODevice::WriteOnly);
+            }
+            m_file.setFileName(path);
+            return m_file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        }
+
+        void write(const QJsonObject &object)
+        {
+            m_file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+            m_file.write("\n", 1);
+        }
+
+        void write(const QByteArray &bytes)
+        {
+            m_file.write(bytes);
+        }
+
+        bool finish()
+        {
+            bool ok = m_file.flush() && m_file.error() == QFileDevice::NoError;
+            m_file.close();
+            return ok;
+        }
+
+    private:
+        QFile m_file;
+    };
+
+    /// Line reader on stdin or a file
+    class LineReader
+    {
+    public:
+        bool open(const QString &path)
+        {
+            if (path.isEmpty() || path == "-")
+            {
+                return m_file.open(stdin, QIODevice::ReadOnly);
+            }
+            m_file.setFileName(path);
+            return m_file.open(QIODevice::ReadOnly);
+        }
+
+        /// Next non-empty, non-comment line, trimmed; false at end of input
+        bool next(QByteArray &line)
+        {
+            while (!m_file.atEnd())
+            {
+                line = m_file.readLine().trimmed();
+                ++m_lineNumber;
+                if (!line.isEmpty() && !line.startsWith('#'))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        int lineNumber() const { return m_lineNumber; }
+
+    private:
+        QFile m_file;
+        int m_lineNumber = 0;
+    };
+
+    /// Per-line problems, capped so a bad file can't flood the summary
+    class ErrorLog
+    {
+    public:
+        void add(int line, const QString &message)
+        {
+            ++m_count;
+            if (m_errors.size() < MAX_REPORTED_ERRORS)
+            {
+                m_errors.append(QJsonObject{{"line", line}, {"message", message}});
+            }
+        }
+
+        int count() const { return m_count; }
+        QJsonArray toJson() const { return m_errors; }
+
+    private:
+        QJsonArray m_errors;
+        int m_count = 0;
+    };
+
+    void printError(const QString &message)
+    {
+        std::fprintf(stderr, "ecim-cli: %s\n", qPrintable(message));
+    }
+
+    int streamComponents(DatabaseManager &db, const ComponentFilter &filter, int limit, const QString &outputPath)
+    {
+        JsonWriter writer;
+        if (!writer.open(outputPath))
+        {
+            printError(QString("cannot write %1").arg(outputPath));
+            return 1;
+        }
+
+        // Rows are formatted into one reused buffer and written out in blocks
+        const bool csv = outputPath != "-" && !outputPath.isEmpty() &&
+                         ComponentExporter::formatForPath(outputPath) == ComponentExporter::Csv;
+        QByteArray buffer = csv ? ComponentExporter::csvHeader() : QByteArray();
+        buffer.reserve(ComponentExporter::WRITE_BUFFER_SIZE + 4096);
+
+        int written = 0;
+        bool ok = db.forEachComponent(filter, [&](const Component &component)
+                                      {
+                                          if (csv)
+                                              ComponentExporter::appendCsvRow(buffer, component);
+                                          else
+                                              ComponentExporter::appendJsonLine(buffer, component);
+                                          if (buffer.size() >= ComponentExporter::WRITE_BUFFER_SIZE)
+                                          {
+                                              writer.write(buffer);
+                                              buffer.truncate(0);
+                                          }
+                                          return limit <= 0 || ++written < limit; });
+        writer.write(buffer);
+        if (!writer.finish())
+        {
+            printError(QString("failed writing %1").arg(outputPath));
+            return 1;
+        }
+        return ok ? 0 : 1;
+    }
+
+    int runStats(DatabaseManager &db)
+    {
+        QJsonArray categories;
+        for (const CategoryInfo &category : db.fetchAllCategories())
+        {
+            QJsonObject entry;
+            entry["name"] = category.name();
+            entry["components"] = db.getComponentCountForCategory(category.name());
+            entry["lowStockThreshold"] = category.lowStockThreshold() >= 0 ? QJsonValue(category.lowStockThreshold()) : QJsonValue();
+            categories.append(entry);
+        }
+
+        QJsonObject stats;
+        stats["database"] = db.databasePath();
+        stats["components"] = db.componentCount();
+        stats["lowStock"] = db.countLowStock();
+        stats["categories"] = categories;
+
+        JsonWriter writer;
+        writer.open("-");
+        writer.write(stats);
+        return writer.finish() ? 0 : 1;
+    }
+
+    /// Lines are "id,delta" or "id delta"; deltas may be negative. The summary is printed once the changes are committed
+    int runAdjust(DatabaseManager &db, const QString &inputPath, QJsonObject &summary)
+    {
+        LineReader reader;
+        if (!reader.open(inputPath))
+        {
+            printError(QString("cannot read %1").arg(inputPath));
+            return 1;
+        }
+
+        static const QRegularExpression separator("[,;\\s]+");
+        std::vector<std::pair<int, int>> batch;
+        batch.reserve(BATCH_SIZE);
+        ErrorLog errors;
+        int adjusted = 0;
+        int lines = 0;
+
+        QByteArray line;
+        while (true)
+        {
+            bool more = reader.next(line);
+            if (more)
+            {
+                ++lines;
+                QStringList fields = QString::fromUtf8(line).split(separator, Qt::SkipEmptyParts);
+                bool idOk = false;
+                bool deltaOk = false;
+                int id = fields.size() == 2 ? fields[0].toInt(&idOk) : 0;
+                int delta = fields.size() == 2 ? fields[1].toInt(&deltaOk) : 0;
+                if (!idOk || !deltaOk)
+                {
+                    errors.add(reader.lineNumber(), "expected \"id,delta\"");
+                    continue;
+                }
+                batch.emplace_back(id, delta);
+            }
+
+            if (batch.size() == BATCH_SIZE || (!more && !batch.empty()))
+            {
+                int changed = db.adjustQuantities(batch);
+                if (changed < 0)
+                {
+                    return 1;
+                }
+                adjusted += changed;
+                batch.clear();
+            }
+            if (!more)
+            {
+                break;
+            }
+        }
+
+        summary = QJsonObject{{"lines", lines}, {"adjusted", adjusted}, {"notFound", lines - errors.count() - adjusted},
+                              {"errorCount", errors.count()}, {"errors", errors.toJson()}};
+        return 0;
+    }
+
+    int runCsvImport(DatabaseManager &db, const QString &inputPath, QJsonObject &summary)
+    {
+        CsvImporter importer(db);
+        CsvImporter::Result result = importer.importFile(inputPath);
+        if (!result.ok)
+        {
+            printError(result.error);
+            return 1;
+        }
+
+        QJsonArray errors;
+        for (const CsvImporter::RowError &error : result.errors)
+        {
+            if (errors.size() >= MAX_REPORTED_ERRORS)
+                break;
+            errors.append(QJsonObject{{"line", error.line}, {"message", error.message}});
+        }
+
+        summary = QJsonObject{{"rows", result.rows}, {"imported", result.imported},
+                              {"errorCount", result.errorCount}, {"errors", errors}};
+        return 0;
+    }
+
+    /// The summary is printed once the imported rows are committed
+    int runImport(DatabaseManager &db, const QString &inputPath, QJsonObject &summary)
+    {
+        QString suffix = QFileInfo(inputPath).suffix().toLower();
+        if (suffix == "csv" || suffix == "tsv")
+        {
+            return runCsvImport(db, inputPath, summary);
+        }
+
+        LineReader reader;
+        if (!reader.open(inputPath))
+        {
+            printError(QString("cannot read %1").arg(inputPath));
+            return 1;
+        }
+
+        std::vector<std::unique_ptr<Component>> batch;
+        batch.reserve(BATCH_SIZE);
+        ErrorLog errors;
+        int imported = 0;
+
+        QByteArray line;
+        while (true)
+        {
+            bool more = reader.next(line);
+            if (more)
+            {
+                QJsonParseError parseError;
+                QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+                if (!doc.isObject())
+                {
+                    errors.add(reader.lineNumber(), parseError.error != QJsonParseError::NoError ? parseError.errorString() : "expected a JSON object");
+                    continue;
+                }
+
+                QString message;
+                std::unique_ptr<Component> component = ComponentJson::fromJson(doc.object(), db.categoryRegistry(), &message);
+                if (!component)
+                {
+                    errors.add(reader.lineNumber(), message);
+                    continue;
+                }
+                // Imported rows always get fresh ids
+                component->setId(-1);
+                batch.push_back(std::move(component));
+            }
+
+            if (static_cast<int>(batch.size()) == BATCH_SIZE || (!more && !batch.empty()))
+            {
+                if (db.addComponents(batch) < 0)
+                {
+                    return 1;
+                }
+                imported += static_cast<int>(batch.size());
+                batch.clear();
+            }
+            if (!more)
+            {
+                break;
+            }
+        }
+
+        summary = QJsonObject{{"imported", imported}, {"errorCount", errors.count()}, {"errors", errors.toJson()}};
+        return 0;
+    }
+
+    int runVacuum(DatabaseManager &db)
+    {
+        QString path = db.databasePath();
+        qint64 before = QFileInfo(path).size();
+        if (!db.vacuum())
+        {
+            return 1;
+        }
+
+        JsonWriter writer;
+        writer.open("-");
+        writer.write(QJsonObject{{"database", path}, {"bytesBefore", before}, {"bytesAfter", QFileInfo(path).size()}});
+        return writer.finish() ? 0 : 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ecim-cli");
+
+    // stdout carries JSON; keep the library's debug chatter out of the way
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Batch queries and updates for an ECIM inventory database.");
+    parser.addHelpOption();
+    QCommandLineOption dbOption("db", "Database file (default: databasePath from the config).", "file");
+    QCommandLineOption configOption("config", "Configuration file.", "file", "config.json");
+    QCommandLineOption categoryOption("category", "Only components in this category.", "name");
+    QCommandLineOption searchOption("search", "Only components whose name contains this text.", "text");
+    QCommandLineOption lowStockOption("low-stock", "Only components below their reorder point.");
+    QCommandLineOption limitOption("limit", "Stop after this many components.", "count", "0");
+    parser.addOptions({dbOption, configOption, categoryOption, searchOption, lowStockOption, limitOption});
+    parser.addPositionalArgument("command", "query, search, stats, adjust, import, export or vacuum.");
+    parser.addPositionalArgument("args", "Command arguments.", "[args...]");
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.isEmpty())
+    {
+        parser.showHelp(2);
+    }
+    const QString command = args[0];
+    const QString argument = args.value(1);
+
+    AppConfig &config = AppConfig::instance();
+    config.load(parser.value(configOption));
+
+    DatabaseManager &db = DatabaseManager::instance();
+    QObject::connect(&db, &DatabaseManager::errorOccurred, [](const QString &message)
+                     { printError(message); });
+
+    QString dbPath = parser.isSet(dbOption) ? parser.value(dbOption) : config.databasePath();
+    if (!db.initialize(dbPath))
+    {
+        return 1;
+    }
+
+    ComponentFilter filter;
+    filter.category = parser.value(categoryOption);
+    filter.nameContains = command == "search" ? argument : parser.value(searchOption);
+    filter.lowStockOnly = parser.isSet(lowStockOption);
+    int limit = parser.value(limitOption).toInt();
+
+    if (command == "vacuum")
+    {
+        return runVacuum(db);
+    }
+
+    // Reads see one consistent snapshot; writes land all together or not at all
+    if (!db.beginTransaction())
+    {
+        return 1;
+    }
+
+    int status = 2;
+    QJsonObject summary; // Written only after a successful commit, so scripts never see an unsaved result
+    if (command == "query" || (command == "search" && !argument.isEmpty()))
+    {
+        status = streamComponents(db, filter, limit, "-");
+    }
+    else if (command == "export")
+    {
+        status = streamComponents(db, filter, limit, argument);
+    }
+    else if (command == "stats")
+    {
+        status = runStats(db);
+    }
+    else if (command == "adjust" && !argument.isEmpty())
+    {
+        status = runAdjust(db, argument, summary);
+    }
+    else if (command == "import" && !argument.isEmpty())
+    {
+        status = runImport(db, argument, summary);
+    }
+
+    if (status == 0)
+    {
+        status = db.commitTransaction() ? 0 : 1;
+        if (status == 0 && !summary.isEmpty())
+        {
+            JsonWriter writer;
+            writer.open("-");
+            writer.write(summary);
+            status = writer.finish() ? 0 : 1;
+        }
+    }
+    else
+    {
+        db.rollbackTransaction();
+    }
+
+    if (status == 2)
+    {
+        printError(QString("unknown command or missing argument: %1").arg(args.join(' ')));
+    }
+    db.close();
+    return status;
+}
@@ -0,0 +1,225 @@
+/**
+ * @brief Build-time helper that compiles language files
+ *
+ * Usage:
+ *   ecim_langtool header <lang.json> <TranslationKeys.h>
+ *   ecim_langtool pack <lang.json> <lang.langpack>
+ *
+ * The header mode turns every key of the reference language file into a
+ * TrKey enumerator, so code can look strings up by index and typos in keys
+ * fail at compile time. The pack mode writes the binary language pack that
+ * LanguageManager maps at startup instead of parsing the JSON.
+ */
+#include "config/TranslationTable.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    bool readLanguageFile(const QString &path, QJsonObject &root)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            std::fprintf(stderr, "Could not open language file: %s\n", qPrintable(path));
+            return false;
+        }
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject())
+        {
+            std::fprintf(stderr, "Invalid language file %s: %s\n", qPrintable(path), qPrintable(error.errorString()));
+            return false;
+        }
+
+        root = doc.object();
+        return true;
+    }
+
+    /// "menu.file.title" -> "MenuFileTitle"
+    QString identifierFor(const QString &key)
+    {
+        QString identifier;
+        for (const QString &part : key.split('.', Qt::SkipEmptyParts))
+        {
+            for (qsizetype i = 0; i < part.size(); ++i)
+            {
+                QChar c = part[i];
+                // Only ASCII is portable in identifiers
+                if (c.unicode() > 0x7f || !c.isLetterOrNumber())
+                {
+                    c = '_';
+                }
+                identifier += (i == 0) ? c.toUpper() : c;
+            }
+        }
+        return identifier;
+    }
+
+    /// Key as the body of a C string literal
+    QString escapedLiteral(const QString &key)
+    {
+        QString escaped;
+        escaped.reserve(key.size());
+        for (QChar c : key)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if (c == '\n')
+                escaped += "\\n";
+            else if (c == '\r')
+                escaped += "\\r";
+            else
+                escaped += c;
+        }
+        return escaped;
+    }
+
+    /**
+     * Map every key to its identifier, or report the first key that has no
+     * valid identifier or shares one with another key
+     */
+    bool identifiersFor(const QStringList &keys, QStringList &identifiers)
+    {
+        QHash<QString, QString> keyByIdentifier;
+        for (const QString &key : keys)
+        {
+            const QString identifier = identifierFor(key);
+            if (identifier.isEmpty() || !(identifier[0].isLetter() || identifier[0] == '_'))
+            {
+                std::fprintf(stderr, "Key \"%s\" does not map to a valid identifier (\"%s\")\n",
+                             qPrintable(key), qPrintable(identifier));
+                return false;
+            }
+            auto existing = keyByIdentifier.constFind(identifier);
+            if (existing != keyByIdentifier.constEnd())
+            {
+                std::fprintf(stderr, "Keys \"%s\" and \"%s\" both map to the identifier %s\n",
+                             qPrintable(existing.value()), qPrintable(key), qPrintable(identifier));
+                return false;
+            }
+            keyByIdentifier.insert(identifier, key);
+            identifiers << identifier;
+        }
+        return true;
+    }
+
+    /// Keys that are looked up from code; "_meta" describes the file itself
+    QStringList codeKeys(const TranslationTable &table)
+    {
+        QStringList keys;
+        for (const auto &entry : table.entries())
+        {
+            if (!entry.key.startsWith('_'))
+            {
+                keys << entry.key;
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    int writeHeader(const QString &jsonPath, const QString &headerPath)
+    {
+        QJsonObject root;
+        if (!readLanguageFile(jsonPath, root))
+        {
+            return 1;
+        }
+
+        TranslationTable table;
+        table.load(root);
+        const QStringList keys = codeKeys(table);
+        QStringList identifiers;
+        if (!identifiersFor(keys, identifiers))
+        {
+            return 1;
+        }
+
+        QSaveFile file(headerPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            std::fprintf(stderr, "Could not write %s\n", qPrintable(headerPath));
+            return 1;
+        }
+
+        QTextStream out(&file);
+        out << "// Generated by ecim_langtool from " << QFileInfo(jsonPath).fileName() << ", do not edit\n"
+            << "#ifndef TRANSLATIONKEYS_H\n"
+            << "#define TRANSLATIONKEYS_H\n\n"
+            << "#include <QtGlobal>\n\n"
+            << "enum class TrKey : quint16\n{\n";
+        for (qsizetype i = 0; i < keys.size(); ++i)
+        {
+            out << "    " << identifiers[i] << ", // " << escapedLiteral(keys[i]) << "\n";
+        }
+        out << "};\n\n"
+            << "inline constexpr int TR_KEY_COUNT = " << keys.size() << ";\n\n"
+            << "inline constexpr const char *TR_KEY_NAMES[TR_KEY_COUNT] = {\n";
+        for (const QString &key : keys)
+        {
+            out << "    \"" << escapedLiteral(key) << "\",\n";
+        }
+        out << "};\n\n"
+            << "#endif // TRANSLATIONKEYS_H\n";
+        out.flush();
+
+        if (!file.commit())
+        {
+            std::fprintf(stderr, "Could not write %s\n", qPrintable(headerPath));
+            return 1;
+        }
+        return 0;
+    }
+
+    int writePack(const QString &jsonPath, const QString &packPath)
+    {
+        QJsonObject root;
+        if (!readLanguageFile(jsonPath, root))
+        {
+            return 1;
+        }
+
+        TranslationTable table;
+        table.load(root);
+
+        QString error;
+        if (!table.writePack(packPath, &error))
+        {
+            std::fprintf(stderr, "Could not write %s: %s\n", qPrintable(packPath), qPrintable(error));
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    if (args.size() == 4 && args[1] == "header")
+    {
+        return writeHeader(args[2], args[3]);
+    }
+    if (args.size() == 4 && args[1] == "pack")
+    {
+        return writePack(args[2], args[3]);
+    }
+
+    std::fprintf(stderr,
+                 "Usage: %s header <lang.json> <TranslationKeys.h>\n"
+                 "       %s pack <lang.json> <lang.langpack>\n",
+                 argv[0], argv[0]);
+    return 2;
+}